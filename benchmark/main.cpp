@@ -0,0 +1,433 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "loguru.hpp"
+#include "argparse/argparse.hpp"
+#include "crillab-panoramyx/core/panoramyx.hpp"
+#include "crillab-panoramyx/network/INetworkCommunication.hpp"
+#include "crillab-panoramyx/network/Message.hpp"
+#include "crillab-panoramyx/network/MessageBuilder.hpp"
+#include "crillab-panoramyx/network/MessagePool.hpp"
+#include "crillab-panoramyx/network/MessageReader.hpp"
+#include "crillab-panoramyx/network/NetworkCommunicationFactory.hpp"
+
+using namespace std;
+using namespace Panoramyx;
+
+/**
+ * @file benchmark/main.cpp
+ * @brief Micro-benchmarks of the network communications, measuring the latency and
+ *        the throughput of their public API independently of any solver.
+ *        The results are written by the communicator 0 on the standard output, in CSV.
+ * @author Thibault Falque
+ * @author Romain Wallon
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+/**
+ * The parameters shared by all the benchmarks.
+ */
+struct BenchmarkConfiguration {
+
+    /**
+     * The name of the measured network communication.
+     */
+    string transport;
+
+    /**
+     * The message sizes to measure, in bytes.
+     */
+    vector<unsigned long> sizes;
+
+    /**
+     * The maximum number of timed iterations for each size.
+     */
+    unsigned long iterations;
+
+    /**
+     * The number of bytes after which no more iterations are run for a given size.
+     */
+    unsigned long volume;
+
+    /**
+     * Gives the number of timed iterations to run for messages of the given size.
+     * Large messages are measured on fewer iterations, so that each size moves about
+     * the same volume of data.
+     *
+     * @param size The size of the messages.
+     *
+     * @return The number of iterations to run.
+     */
+    [[nodiscard]] unsigned long iterationsFor(unsigned long size) const {
+        return max(1UL, min(iterations, volume / size));
+    }
+};
+
+/**
+ * Writes the header of the CSV output.
+ */
+void printHeader() {
+    cout << "benchmark,transport,processes,size,iterations,total_us,avg_us,throughput_MBps" << endl;
+}
+
+/**
+ * Writes one line of the CSV output.
+ *
+ * @param benchmark The name of the benchmark.
+ * @param configuration The configuration of the benchmarks.
+ * @param processes The number of communicators involved in the benchmark.
+ * @param size The size of the messages.
+ * @param iterations The number of timed iterations.
+ * @param elapsed The time needed to run all the iterations.
+ * @param operations The number of operations in each iteration (the average is per operation).
+ * @param bytes The number of bytes moved by each iteration.
+ */
+void printResult(const string &benchmark, const BenchmarkConfiguration &configuration, int processes,
+                 unsigned long size, unsigned long iterations, chrono::nanoseconds elapsed,
+                 unsigned long operations, unsigned long bytes) {
+    double total = (double) elapsed.count() / 1000.;
+    double average = total / (double) (iterations * operations);
+    double throughput = (total > 0) ? ((double) (bytes * iterations) / total) : 0.;
+    printf("%s,%s,%d,%lu,%lu,%.3f,%.3f,%.3f\n", benchmark.c_str(), configuration.transport.c_str(),
+           processes, size, iterations, total, average, throughput);
+    fflush(stdout);
+}
+
+/**
+ * Creates a message having a payload of the given size.
+ *
+ * @param tag The tag of the message.
+ * @param payload The payload of the message.
+ *
+ * @return The created message.
+ */
+Message *createMessage(int tag, const string &payload) {
+    MessageBuilder mb;
+    mb.reserve(payload.size() + sizeof(unsigned long long)).withTag(tag).withString(payload);
+    return mb.build();
+}
+
+/**
+ * Creates an empty message, used to synchronize the communicators.
+ *
+ * @param tag The tag of the message.
+ *
+ * @return The created message.
+ */
+Message *createSignal(int tag) {
+    MessageBuilder mb;
+    return mb.withTag(tag).build();
+}
+
+/**
+ * Measures the round-trip of messages between the communicators 0 and 1.
+ * The reported average is the one-way latency.
+ *
+ * @param comm The network communication to measure.
+ * @param configuration The configuration of the benchmarks.
+ */
+void pingPong(INetworkCommunication *comm, const BenchmarkConfiguration &configuration) {
+    int id = comm->getId();
+    if (id > 1) {
+        return;
+    }
+
+    int peer = 1 - id;
+    for (auto size : configuration.sizes) {
+        string payload(size, 'p');
+        Message *message = createMessage(PANO_TAG_SOLVE, payload);
+        unsigned long iterations = configuration.iterationsFor(size);
+
+        // The first round trip is not timed, as it may establish the connection.
+        chrono::steady_clock::time_point start;
+        for (unsigned long i = 0; i <= iterations; i++) {
+            if (i == 1) {
+                start = chrono::steady_clock::now();
+            }
+            if (id == 0) {
+                comm->send(message, peer);
+                MessagePool::release(comm->receive(PANO_TAG_SOLVE, peer));
+            } else {
+                MessagePool::release(comm->receive(PANO_TAG_SOLVE, peer));
+                comm->send(message, peer);
+            }
+        }
+
+        if (id == 0) {
+            printResult("ping-pong", configuration, 2, size, iterations,
+                        chrono::steady_clock::now() - start, 2, 2 * size);
+        }
+        MessagePool::release(message);
+    }
+}
+
+/**
+ * Measures the sending of a message from the communicator 0 to all the others.
+ * An iteration ends when the communicator 0 has received an acknowledgment from all
+ * the other communicators.
+ *
+ * @param comm The network communication to measure.
+ * @param configuration The configuration of the benchmarks.
+ * @param useBroadcast Whether the message is sent with broadcast() instead of one send()
+ *        per destination.
+ */
+void fanOut(INetworkCommunication *comm, const BenchmarkConfiguration &configuration, bool useBroadcast) {
+    int id = comm->getId();
+    int nb = comm->nbProcesses();
+    vector<int> ranks;
+    for (int i = 1; i < nb; i++) {
+        ranks.push_back(i);
+    }
+
+    Message *ack = createSignal(PANO_TAG_RESPONSE);
+    for (auto size : configuration.sizes) {
+        unsigned long iterations = configuration.iterationsFor(size);
+        Message *message = nullptr;
+        if (id == 0) {
+            string payload(size, 'o');
+            message = createMessage(PANO_TAG_SOLVE, payload);
+        }
+
+        chrono::steady_clock::time_point start;
+        for (unsigned long i = 0; i <= iterations; i++) {
+            if (i == 1) {
+                start = chrono::steady_clock::now();
+            }
+            if (id == 0) {
+                if (useBroadcast) {
+                    comm->broadcast(message, ranks);
+                } else {
+                    for (auto dest : ranks) {
+                        comm->send(message, dest);
+                    }
+                }
+                for (unsigned long j = 0; j < ranks.size(); j++) {
+                    MessagePool::release(comm->receive(PANO_TAG_RESPONSE, PANO_ANY_SOURCE));
+                }
+
+            } else {
+                // Broadcast messages may be forwarded by any communicator.
+                MessagePool::release(comm->receive(PANO_TAG_SOLVE, PANO_ANY_SOURCE));
+                comm->send(ack, 0);
+            }
+        }
+
+        if (id == 0) {
+            printResult(useBroadcast ? "fan-out-broadcast" : "fan-out", configuration, nb, size, iterations,
+                        chrono::steady_clock::now() - start, 1, ranks.size() * size);
+            MessagePool::release(message);
+        }
+    }
+    MessagePool::release(ack);
+}
+
+/**
+ * Measures the sending of a message from all the communicators to the communicator 0.
+ * Each iteration is started by an empty message sent by the communicator 0, and ends
+ * when it has received the messages of all the other communicators.
+ *
+ * @param comm The network communication to measure.
+ * @param configuration The configuration of the benchmarks.
+ */
+void fanIn(INetworkCommunication *comm, const BenchmarkConfiguration &configuration) {
+    int id = comm->getId();
+    int nb = comm->nbProcesses();
+
+    Message *go = createSignal(PANO_TAG_CONFIG);
+    for (auto size : configuration.sizes) {
+        unsigned long iterations = configuration.iterationsFor(size);
+        Message *message = nullptr;
+        if (id != 0) {
+            string payload(size, 'i');
+            message = createMessage(PANO_TAG_SOLVE, payload);
+        }
+
+        chrono::steady_clock::time_point start;
+        for (unsigned long i = 0; i <= iterations; i++) {
+            if (i == 1) {
+                start = chrono::steady_clock::now();
+            }
+            if (id == 0) {
+                for (int dest = 1; dest < nb; dest++) {
+                    comm->send(go, dest);
+                }
+                for (int j = 1; j < nb; j++) {
+                    MessagePool::release(comm->receive(PANO_TAG_SOLVE, PANO_ANY_SOURCE));
+                }
+
+            } else {
+                MessagePool::release(comm->receive(PANO_TAG_CONFIG, 0));
+                comm->send(message, 0);
+            }
+        }
+
+        if (id == 0) {
+            printResult("fan-in", configuration, nb, size, iterations,
+                        chrono::steady_clock::now() - start, 1, (nb - 1) * size);
+        } else {
+            MessagePool::release(message);
+        }
+    }
+    MessagePool::release(go);
+}
+
+/**
+ * Measures the building and the parsing of messages, without sending them.
+ * Two kinds of messages are measured: messages made of a single string (such as
+ * instances or solutions), and messages made of many small integers (such as cubes).
+ *
+ * @param configuration The configuration of the benchmarks.
+ */
+void builderThroughput(const BenchmarkConfiguration &configuration) {
+    for (auto size : configuration.sizes) {
+        unsigned long iterations = configuration.iterationsFor(size);
+        string payload(size, 'b');
+        unsigned long checksum = 0;
+
+        auto start = chrono::steady_clock::now();
+        for (unsigned long i = 0; i < iterations; i++) {
+            Message *message = createMessage(PANO_TAG_SOLVE, payload);
+            MessageReader reader(message);
+            checksum += reader.readString().size();
+            MessagePool::release(message);
+        }
+        printResult("builder-string", configuration, 1, size, iterations,
+                    chrono::steady_clock::now() - start, 1, size);
+
+        unsigned long nbIntegers = max(1UL, size / sizeof(long long));
+        start = chrono::steady_clock::now();
+        for (unsigned long i = 0; i < iterations; i++) {
+            MessageBuilder mb;
+            mb.reserve(size).withTag(PANO_TAG_SOLVE);
+            for (unsigned long j = 0; j < nbIntegers; j++) {
+                mb.withInteger((long long) (j * 2654435761UL) - (long long) i);
+            }
+            Message *message = mb.build();
+            MessageReader reader(message);
+            for (unsigned long j = 0; j < nbIntegers; j++) {
+                checksum += reader.readInteger();
+            }
+            MessagePool::release(message);
+        }
+        printResult("builder-integers", configuration, 1, size, iterations,
+                    chrono::steady_clock::now() - start, 1, nbIntegers * sizeof(long long));
+
+        // Prevents the compiler from removing the parsing.
+        if (checksum == 0) {
+            cerr << "unexpected empty messages" << endl;
+        }
+    }
+}
+
+INetworkCommunication *parseTransport(argparse::ArgumentParser &program, NetworkCommunicationFactory &networkCommunicationFactory) {
+    if (program.get<string>("network-communicator") == "MPI") {
+        return networkCommunicationFactory.createMPINetworkCommunication(program.get<int>("mpi-chunk-size"));
+    } else if (program.get<string>("network-communicator") == "thread") {
+        return networkCommunicationFactory.createThreadCommunication(program.get<int>("nthread"));
+    } else if (program.get<string>("network-communicator") == "hybrid") {
+        return networkCommunicationFactory.createHybridCommunication(program.get<int>("nthread"));
+    } else if (program.get<string>("network-communicator") == "shm") {
+        return networkCommunicationFactory.createSharedMemoryCommunication(
+                program.get<int>("nprocesses"), program.get<int>("shm-ring-size"));
+    }
+    throw runtime_error("invalid network communicator");
+}
+
+void addArguments(argparse::ArgumentParser &parser) {
+    parser.add_argument("-c", "--network-communicator")
+            .default_value(std::string{"MPI"})
+            .action([](const std::string &value) {
+                static const std::vector<std::string> choices = {"MPI", "thread", "shm", "hybrid"};
+                if (std::find(choices.begin(), choices.end(), value) != choices.end()) {
+                    return value;
+                }
+                throw runtime_error("Unknown communicator value " + value);
+            });
+    parser.add_argument("--mpi-chunk-size")
+            .default_value((int) PANO_DEFAULT_CHUNK_SIZE)
+            .scan<'i', int>()
+            .help("specify the maximum number of bytes sent in a single MPI transfer");
+    parser.add_argument("--nprocesses")
+            .default_value(2)
+            .scan<'i', int>()
+            .help("specify the number of processes (with the shm communicator)");
+    parser.add_argument("--shm-ring-size")
+            .default_value((int) PANO_DEFAULT_RING_SIZE)
+            .scan<'i', int>()
+            .help("specify the size of the shared memory buffers between processes");
+    parser.add_argument("--nthread")
+            .default_value(2)
+            .scan<'i', int>()
+            .help("specify the number of threads (with the thread and hybrid communicators)");
+    parser.add_argument("--min-size")
+            .default_value(16)
+            .scan<'i', int>()
+            .help("specify the size of the smallest measured messages, in bytes");
+    parser.add_argument("--max-size")
+            .default_value(64 << 20)
+            .scan<'i', int>()
+            .help("specify the size of the largest measured messages, in bytes");
+    parser.add_argument("--iterations")
+            .default_value(1000)
+            .scan<'i', int>()
+            .help("specify the maximum number of iterations for each message size");
+    parser.add_argument("--volume")
+            .default_value(256)
+            .scan<'i', int>()
+            .help("specify the number of megabytes after which no more iterations are run for a message size");
+    parser.add_argument("--skip-builder")
+            .default_value(false)
+            .implicit_value(true)
+            .help("do not measure the building and parsing of messages");
+}
+
+int main(int argc, char **argv) {
+    loguru::g_stderr_verbosity = loguru::Verbosity_WARNING;
+    loguru::init(argc, argv);
+    argparse::ArgumentParser program("panobench", PANO_VERSION);
+    addArguments(program);
+    program.parse_args(argc, argv);
+
+    BenchmarkConfiguration configuration;
+    configuration.transport = program.get<string>("network-communicator");
+    configuration.iterations = program.get<int>("iterations");
+    configuration.volume = ((unsigned long) program.get<int>("volume")) << 20;
+    auto maxSize = (unsigned long) program.get<int>("max-size");
+    for (auto size = (unsigned long) max(1, program.get<int>("min-size")); size <= maxSize; size *= 4) {
+        configuration.sizes.push_back(size);
+    }
+
+    NetworkCommunicationFactory networkCommunicationFactory(&argc, &argv);
+    auto *networkCommunication = parseTransport(program, networkCommunicationFactory);
+    bool skipBuilder = program.get<bool>("skip-builder");
+
+    networkCommunication->start([=, &configuration]() {
+        // The identifier must be read here, as the runnable may run in several threads.
+        int id = networkCommunication->getId();
+        if (id == 0) {
+            printHeader();
+        }
+
+        if (networkCommunication->nbProcesses() < 2) {
+            if (id == 0) {
+                cerr << "at least 2 communicators are needed to measure the network communication" << endl;
+            }
+
+        } else {
+            pingPong(networkCommunication, configuration);
+            fanOut(networkCommunication, configuration, false);
+            fanOut(networkCommunication, configuration, true);
+            fanIn(networkCommunication, configuration);
+        }
+
+        if ((id == 0) && (!skipBuilder)) {
+            builderThroughput(configuration);
+        }
+    });
+    networkCommunication->finalize();
+    return 0;
+}
@@ -155,12 +155,51 @@ void addCommonArguments(argparse::ArgumentParser &parser) {
     parser.add_argument("-c", "--network-communicator")
             .default_value(std::string{"MPI"})
             .action([](const std::string &value) {
-                static const std::vector<std::string> choices = {"MPI","thread"};
+                static const std::vector<std::string> choices = {"MPI","thread","shm","hybrid"};
                 if (std::find(choices.begin(), choices.end(), value) != choices.end()) {
                     return value;
                 }
                 throw runtime_error("Unknown communicator value " + value);
             });
+    parser.add_argument("--mpi-chunk-size")
+            .default_value((int) PANO_DEFAULT_CHUNK_SIZE)
+            .scan<'i', int>()
+            .help("specify the maximum number of bytes sent in a single MPI transfer");
+    parser.add_argument("--nprocesses")
+            .default_value(1)
+            .scan<'i', int>()
+            .help("specify the number of processes (with the shm communicator)");
+    parser.add_argument("--shm-ring-size")
+            .default_value((int) PANO_DEFAULT_RING_SIZE)
+            .scan<'i', int>()
+            .help("specify the size of the shared memory buffers between processes");
+    parser.add_argument("--broadcast-instance")
+            .default_value(false)
+            .implicit_value(true)
+            .help("read the instance once and send it to the solvers (no shared filesystem is needed)");
+    parser.add_argument("--network-report")
+            .default_value(std::string{""})
+            .help("specify the prefix of the files in which to write metrics about the messages exchanged");
+    parser.add_argument("--compress")
+            .default_value(false)
+            .implicit_value(true)
+            .help("compress the large messages exchanged by the solvers");
+    parser.add_argument("--compression-threshold")
+            .default_value((int) PANO_DEFAULT_COMPRESSION_THRESHOLD)
+            .scan<'i', int>()
+            .help("specify the size of the messages above which they are compressed");
+    parser.add_argument("--solution-attachment-limit")
+            .default_value((int) PANO_DEFAULT_SOLUTION_ATTACHMENT_LIMIT)
+            .scan<'i', int>()
+            .help("specify the estimated size of the solutions above which they are not sent with the result of the solvers (0 to never send them)");
+    parser.add_argument("--solution-delta")
+            .default_value(false)
+            .implicit_value(true)
+            .help("only send the values that have changed since the previous solution sent by a solver");
+    parser.add_argument("--incremental")
+            .default_value(false)
+            .implicit_value(true)
+            .help("declare that the solvers keep their root state after a search, so that they are not reset between the cubes");
     parser.add_argument("--nthread")
             .default_value<std::vector<int>>({})
             .scan<'i', int>()
@@ -191,16 +230,35 @@ argparse::ArgumentParser parse(int argc, char **argv) {
 }
 
 
-INetworkCommunication *parseNetworkCommunication(argparse::ArgumentParser &program, int *argc, char ***argv) {
-    NetworkCommunicationFactory networkCommunicationFactory(argc, argv);
+INetworkCommunication *parseTransport(argparse::ArgumentParser &program, NetworkCommunicationFactory &networkCommunicationFactory) {
     if (program.get<string>("network-communicator") == "MPI") {
-        return networkCommunicationFactory.createMPINetworkCommunication();
+        return networkCommunicationFactory.createMPINetworkCommunication(program.get<int>("mpi-chunk-size"));
     }else if (program.get<string>("network-communicator") == "thread") {
         return networkCommunicationFactory.createThreadCommunication(program.get<int>("nthread"));
+    }else if (program.get<string>("network-communicator") == "hybrid") {
+        return networkCommunicationFactory.createHybridCommunication(program.get<int>("nthread"));
+    }else if (program.get<string>("network-communicator") == "shm") {
+        return networkCommunicationFactory.createSharedMemoryCommunication(
+                program.get<int>("nprocesses"), program.get<int>("shm-ring-size"));
     }
     throw runtime_error("invalid network communicator");
 }
 
+INetworkCommunication *parseNetworkCommunication(argparse::ArgumentParser &program, int *argc, char ***argv) {
+    NetworkCommunicationFactory networkCommunicationFactory(argc, argv);
+    auto *networkCommunication = parseTransport(program, networkCommunicationFactory);
+    if (!program.get<string>("network-report").empty()) {
+        // Instrumenting the transport itself measures the messages as they are actually sent.
+        networkCommunication = networkCommunicationFactory.createInstrumentedCommunication(
+                networkCommunication, program.get<string>("network-report"));
+    }
+    if (program.get<bool>("compress")) {
+        return networkCommunicationFactory.createCompressedCommunication(
+                networkCommunication, program.get<int>("compression-threshold"));
+    }
+    return networkCommunication;
+}
+
 void parseConsistencyChecker(argparse::ArgumentParser &program, ICubeGenerator *cg) {
     const std::string &consistency = program.get<string>("consistency-checker-solver");
     Universe::IUniverseSolver *solver;
@@ -351,9 +409,10 @@ int main(int argc, char **argv) {
     bool decompose = program.get<bool>("decompose");
     buildJVM(program);
 
-    int id = networkCommunication->getId();
     int nbChiefs = (nb - 1) / (nbPartitions + 1);
     networkCommunication->start([=,&program]() {
+        // The identifier must be read here, as the runnable may run in several threads.
+        int id = networkCommunication->getId();
         if (id == 0) {
             atexit(atExit);
             AbstractSolverBuilder *asb;
@@ -363,7 +422,8 @@ int main(int argc, char **argv) {
                                            networkCommunication))->withNetworkCommunicator(
                         networkCommunication)->withJavaOptions(
                         splitJavaOptions(program.get<string>("java-options")))->withJars(
-                        program.get<std::vector<string>>("jars"));
+                        program.get<std::vector<string>>("jars"))->withInstanceBroadcast(
+                        program.get<bool>("broadcast-instance"));
 
             } else {
                 asb = (new PortfolioSolverBuilder())->withAllocationStrategy(
@@ -371,7 +431,8 @@ int main(int argc, char **argv) {
                                                 networkCommunication))->withNetworkCommunicator(
                         networkCommunication)->withJavaOptions(
                         splitJavaOptions(program.get<string>("java-options")))->withJars(
-                        program.get<std::vector<string>>("jars"));
+                        program.get<std::vector<string>>("jars"))->withInstanceBroadcast(
+                        program.get<bool>("broadcast-instance"));
 
             }
             chief = asb->build();
@@ -392,6 +453,7 @@ int main(int argc, char **argv) {
                 std::filesystem::create_directory(logdir);
             }
             PartitionSolver *solver = new PartitionSolver(networkCommunication, createHypergraphDecompositionSolver(program, program.at<argparse::ArgumentParser>("eps")));
+            solver->setInstanceBroadcast(program.get<bool>("broadcast-instance"));
             for (int i = 1; i <= nbPartitions; i++) {
                 solver->addSolver(new RemoteSolver(nbChiefs + (id - 1) * nbPartitions + i));
             }
@@ -399,6 +461,9 @@ int main(int argc, char **argv) {
             gaulois->setLogFile(logdir + separator() + "log_partition_" +
                                 std::to_string(id) + "_" + std::to_string(getpid()) +
                                 ".log");
+            gaulois->setSolutionAttachmentLimit(program.get<int>("solution-attachment-limit"));
+            gaulois->setSolutionDelta(program.get<bool>("solution-delta"));
+            gaulois->setCapabilities(program.get<bool>("incremental") ? PANO_CAPABILITY_INCREMENTAL : 0);
             gaulois->start();
 
         } else if (!decompose || id < (1 + nbChiefs + nbChiefs * nbPartitions)){
@@ -424,12 +489,15 @@ int main(int argc, char **argv) {
             gaulois->setLogFile(logdir + separator() + "log_gaulois_" +
                                 std::to_string(id) + "_" + std::to_string(getpid()) +
                                 ".log");
+            gaulois->setSolutionAttachmentLimit(program.get<int>("solution-attachment-limit"));
+            gaulois->setSolutionDelta(program.get<bool>("solution-delta"));
+            gaulois->setCapabilities(program.get<bool>("incremental") ? PANO_CAPABILITY_INCREMENTAL : 0);
             gaulois->start();
         } else {
             LOG_F(INFO, "terminating useless process %d", id);
         }
     });
-    LOG_F(INFO, "#%d is waiting to terminate", id);
+    LOG_F(INFO, "#%d is waiting to terminate", networkCommunication->getId());
     networkCommunication->finalize();
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,92 @@
+/**
+ * PANORAMYX - Programming pArallel coNstraint sOlveRs mAde aMazingly easY.
+ * Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see {@link http://www.gnu.org/licenses}.
+ */
+
+/**
+ * @file CompletedNetworkRequest.hpp
+ * @brief A network request that has already completed.
+ *
+ * @author Thibault Falque
+ * @author Romain Wallon
+ *
+ * @copyright Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#ifndef PANORAMYX_COMPLETEDNETWORKREQUEST_HPP
+#define PANORAMYX_COMPLETEDNETWORKREQUEST_HPP
+
+#include "INetworkRequest.hpp"
+
+namespace Panoramyx {
+
+    /**
+     * The CompletedNetworkRequest is a request for a communication that has
+     * been performed immediately, as it happens for transports that do not
+     * need to wait for the network.
+     */
+    class CompletedNetworkRequest : public Panoramyx::INetworkRequest {
+
+    private:
+
+        /**
+         * The received message (if any).
+         */
+        Message *message;
+
+    public:
+
+        /**
+         * Creates a new CompletedNetworkRequest.
+         *
+         * @param message The received message, or nullptr for a send request.
+         */
+        explicit CompletedNetworkRequest(Message *message = nullptr);
+
+        /**
+         * Destroys this CompletedNetworkRequest.
+         * The received message is released if it has not been retrieved.
+         */
+        ~CompletedNetworkRequest() override;
+
+        /**
+         * Checks whether the communication has completed, without blocking.
+         *
+         * @return Always true.
+         */
+        bool test() override;
+
+        /**
+         * Waits until the communication has completed.
+         * This method returns immediately.
+         */
+        void wait() override;
+
+        /**
+         * Gives the message received by this request, if any.
+         *
+         * @return The received message, or nullptr.
+         */
+        Message *getMessage() override;
+
+    };
+
+}
+
+#endif
@@ -0,0 +1,171 @@
+/**
+ * PANORAMYX - Programming pArallel coNstraint sOlveRs mAde aMazingly easY.
+ * Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see {@link http://www.gnu.org/licenses}.
+ */
+
+/**
+ * @file CompressedNetworkCommunication.hpp
+ * @brief Provides a communication compressing the large messages sent by another communication.
+ *
+ * @author Thibault Falque
+ * @author Romain Wallon
+ *
+ * @copyright Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#ifndef PANORAMYX_COMPRESSEDNETWORKCOMMUNICATION_HPP
+#define PANORAMYX_COMPRESSEDNETWORKCOMMUNICATION_HPP
+
+#include <atomic>
+
+#include "NetworkCommunicationDecorator.hpp"
+
+namespace Panoramyx {
+
+    /**
+     * The CompressedNetworkCommunication compresses (with the MessageCompressor) the
+     * parameters of the messages whose size exceeds a given threshold before they are
+     * sent by the decorated communication, and transparently decompresses them when
+     * they are received.
+     * Messages on which compression does not save any byte are sent as is.
+     *
+     * All the communicators exchanging messages must be decorated, as the messages
+     * they receive may be compressed.
+     */
+    class CompressedNetworkCommunication : public Panoramyx::NetworkCommunicationDecorator {
+
+    private:
+
+        /**
+         * The size (in bytes) of the parameters above which a message is compressed.
+         */
+        unsigned long threshold;
+
+        /**
+         * The number of messages that have been compressed.
+         */
+        std::atomic<unsigned long> nbCompressed;
+
+        /**
+         * The total size of the parameters of the compressed messages, before compression.
+         */
+        std::atomic<unsigned long> originalBytes;
+
+        /**
+         * The total size of the parameters of the compressed messages, after compression.
+         */
+        std::atomic<unsigned long> compressedBytes;
+
+    public:
+
+        /**
+         * Creates a new CompressedNetworkCommunication.
+         *
+         * @param decorated The communication to decorate.
+         * @param threshold The size (in bytes) of the parameters above which a message is compressed.
+         */
+        CompressedNetworkCommunication(Panoramyx::INetworkCommunication *decorated, unsigned long threshold);
+
+        /**
+         * Receives a message, and decompresses it if needed.
+         *
+         * @param tag The tag identifying the kind of the message to read.
+         * @param src The identifier of the source of the message.
+         *
+         * @return The received message.
+         */
+        Message *receive(int tag, int src) override;
+
+        /**
+         * Sends a message, compressed if it is large enough.
+         *
+         * @param message The message to send.
+         * @param dest The identifier of the destination of the message.
+         */
+        void send(Message *message, int dest) override;
+
+        /**
+         * Sends a message, compressed if it is large enough, transferring its
+         * ownership to this communication.
+         *
+         * @param message The message to send.
+         * @param dest The identifier of the destination of the message.
+         */
+        void transfer(Message *message, int dest) override;
+
+        /**
+         * Starts receiving a message, without blocking.
+         * The message is decompressed (if needed) when it is retrieved from the request.
+         *
+         * @param tag The tag identifying the kind of the message to read.
+         * @param src The identifier of the source of the message.
+         *
+         * @return The request to use to retrieve the message once received.
+         */
+        INetworkRequest *irecv(int tag, int src) override;
+
+        /**
+         * Starts sending a message, compressed if it is large enough, without blocking.
+         *
+         * @param message The message to send.
+         * @param dest The identifier of the destination of the message.
+         *
+         * @return The request to use to wait for the message to be sent.
+         */
+        INetworkRequest *isend(Message *message, int dest) override;
+
+        /**
+         * Sends the same message, compressed if it is large enough, to several communicators.
+         *
+         * @param message The message to send.
+         * @param ranks The identifiers of the communicators that will receive the message.
+         */
+        void broadcast(Message *message, const std::vector<int> &ranks) override;
+
+        /**
+         * Reports the compression statistics, and finalizes the decorated communication.
+         */
+        void finalize() override;
+
+        /**
+         * Decompresses a received message, if it is compressed.
+         * In this case, the received message is released.
+         *
+         * @param message The received message (may be nullptr).
+         *
+         * @return The decompressed message.
+         */
+        static Message *decompress(Message *message);
+
+    private:
+
+        /**
+         * Compresses a message that is about to be sent, if it is large enough.
+         *
+         * @param message The message to compress.
+         *
+         * @return The compressed message, or nullptr if the message is not compressed.
+         */
+        Message *compress(const Message *message);
+
+    };
+
+}
+
+#endif
@@ -0,0 +1,91 @@
+/**
+ * PANORAMYX - Programming pArallel coNstraint sOlveRs mAde aMazingly easY.
+ * Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see {@link http://www.gnu.org/licenses}.
+ */
+
+/**
+ * @file CompressedReceiveRequest.hpp
+ * @brief Represents a message being received by a CompressedNetworkCommunication.
+ *
+ * @author Thibault Falque
+ * @author Romain Wallon
+ *
+ * @copyright Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#ifndef PANORAMYX_COMPRESSEDRECEIVEREQUEST_HPP
+#define PANORAMYX_COMPRESSEDRECEIVEREQUEST_HPP
+
+#include "INetworkRequest.hpp"
+
+namespace Panoramyx {
+
+    /**
+     * The CompressedReceiveRequest wraps a receive request of the decorated
+     * communication, so as to decompress the received message (if needed) when
+     * it is retrieved.
+     */
+    class CompressedReceiveRequest : public Panoramyx::INetworkRequest {
+
+    private:
+
+        /**
+         * The request receiving the (possibly compressed) message.
+         */
+        Panoramyx::INetworkRequest *request;
+
+    public:
+
+        /**
+         * Creates a new CompressedReceiveRequest.
+         *
+         * @param request The request receiving the (possibly compressed) message.
+         *        Its ownership is transferred to this request.
+         */
+        explicit CompressedReceiveRequest(Panoramyx::INetworkRequest *request);
+
+        /**
+         * Destroys this CompressedReceiveRequest, and the wrapped request.
+         */
+        ~CompressedReceiveRequest() override;
+
+        /**
+         * Checks whether the message has been received, without blocking.
+         *
+         * @return Whether the message has been received.
+         */
+        bool test() override;
+
+        /**
+         * Waits until the message has been received.
+         */
+        void wait() override;
+
+        /**
+         * Gives the received message, decompressed if needed.
+         *
+         * @return The received message, or nullptr.
+         */
+        Message *getMessage() override;
+
+    };
+
+}
+
+#endif
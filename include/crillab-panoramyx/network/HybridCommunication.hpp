@@ -0,0 +1,258 @@
+/**
+ * PANORAMYX - Programming pArallel coNstraint sOlveRs mAde aMazingly easY.
+ * Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see {@link http://www.gnu.org/licenses}.
+ */
+
+/**
+ * @file HybridCommunication.hpp
+ * @brief An implementation of INetworkCommunication combining MPI between processes and threads inside them.
+ *
+ * @author Thibault Falque
+ * @author Romain Wallon
+ *
+ * @copyright Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#ifndef PANORAMYX_HYBRIDCOMMUNICATION_HPP
+#define PANORAMYX_HYBRIDCOMMUNICATION_HPP
+
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <mpi.h>
+
+#include "INetworkCommunication.hpp"
+#include "MessageMailbox.hpp"
+
+namespace Panoramyx {
+
+    /**
+     * The HybridCommunication is an implementation of INetworkCommunication
+     * that runs several threads in each MPI process (typically, one process per node).
+     * The communicator of the i-th thread of the process of rank r is identified
+     * by r * nbThreads + i.
+     * Messages between threads of the same process are delivered to the mailbox of
+     * their destination without going through MPI, while messages to other processes
+     * are sent with MPI (using the destination identifier as MPI tag), and delivered
+     * to the right mailbox by a progress thread of the receiving process.
+     * As with MPINetworkCommunication, messages that are larger than the chunk size
+     * are split into a first part and chunks sent on a dedicated communicator.
+     */
+    class HybridCommunication : public Panoramyx::INetworkCommunication {
+
+    private:
+
+        /**
+         * The number of threads to run in each process.
+         */
+        int nbThreads;
+
+        /**
+         * The MPI communicator used by this communication.
+         */
+        MPI_Comm communicator;
+
+        /**
+         * The communicator on which the chunks of large messages are sent.
+         */
+        MPI_Comm chunkCommunicator;
+
+        /**
+         * The maximum number of bytes sent in a single MPI transfer.
+         */
+        unsigned long chunkSize;
+
+        /**
+         * The mutex ensuring that the chunks of different messages are not interleaved.
+         */
+        std::mutex chunkMutex;
+
+        /**
+         * The rank of the current process, as assigned by MPI.
+         */
+        int rank;
+
+        /**
+         * The number of MPI processes.
+         */
+        int worldSize;
+
+        /**
+         * The running threads.
+         */
+        std::vector<std::thread> threads;
+
+        /**
+         * The thread receiving the messages sent by the other processes.
+         */
+        std::thread progressThread;
+
+        /**
+         * The mailboxes in which the messages are delivered to each thread of the process.
+         */
+        std::vector<Panoramyx::MessageMailbox *> mailboxes;
+
+        /**
+         * The index of the current thread in its process.
+         * Threads that have not been started by a HybridCommunication have index 0,
+         * unless they execute a runnable bound with attach().
+         */
+        static thread_local int threadIndex;
+
+        /**
+         * Checks whether a communicator runs in the current process.
+         *
+         * @param id The identifier of the communicator.
+         *
+         * @return Whether the communicator is local.
+         */
+        bool isLocal(int id) const;
+
+        /**
+         * Gives the mailbox of a communicator running in the current process.
+         *
+         * @param id The identifier of the communicator.
+         *
+         * @return The mailbox of the communicator.
+         */
+        Panoramyx::MessageMailbox *mailboxOf(int id);
+
+        /**
+         * Receives the messages sent by the other processes and delivers them to
+         * their mailbox, until this communication is finalized.
+         */
+        void progress();
+
+        /**
+         * Sends a message to a communicator running in another process, splitting it
+         * into chunks if needed.
+         *
+         * @param message The message to send.
+         * @param dest The identifier of the destination of the message.
+         */
+        void sendRemote(const Message *message, int dest);
+
+    public:
+
+        /**
+         * Creates a new HybridCommunication.
+         * MPI must have been initialized with MPI_THREAD_MULTIPLE.
+         *
+         * @param nbThreads The number of threads to run in each process.
+         * @param chunkSize The maximum number of bytes sent in a single MPI transfer.
+         *
+         * @throws Except::IllegalArgumentException If there are too many communicators
+         *         to be identified by MPI tags.
+         */
+        explicit HybridCommunication(int nbThreads, unsigned long chunkSize = PANO_DEFAULT_CHUNK_SIZE);
+
+        /**
+         * Destroys this HybridCommunication.
+         */
+        ~HybridCommunication() override;
+
+        /**
+         * Gives the identifier of the current communicator.
+         *
+         * @return The identifier of the current communicator.
+         */
+        int getId() override;
+
+        /**
+         * Gives the number of processes that are currently communicating.
+         *
+         * @return The number of processes.
+         */
+        int nbProcesses() override;
+
+        /**
+         * Executes the given runnable as many times as needed by this strategy.
+         *
+         * @param runnable The runnable to execute.
+         */
+        void start(std::function<void()> runnable) override;
+
+        /**
+         * Binds a runnable to the current communicator, so that a helper thread
+         * executing it uses the identifier of the current thread.
+         *
+         * @param runnable The runnable to bind.
+         *
+         * @return The bound runnable.
+         */
+        std::function<void()> attach(std::function<void()> runnable) override;
+
+        /**
+         * Receives a message.
+         *
+         * @param tag The tag identifying the kind of the message to read.
+         * @param src The identifier of the source of the message (i.e., the communicator that sent it).
+         *
+         * @return The received message.
+         */
+        Message *receive(int tag, int src) override;
+
+        /**
+         * Sends a message.
+         *
+         * @param message The message to send.
+         * @param dest The identifier of the destination of the message (i.e., the communicator that will receive it).
+         */
+        void send(Message *message, int dest) override;
+
+        /**
+         * Sends a message, transferring its ownership to this communication.
+         * Messages to local threads are delivered without being copied.
+         *
+         * @param message The message to send.
+         * @param dest The identifier of the destination of the message (i.e., the communicator that will receive it).
+         */
+        void transfer(Message *message, int dest) override;
+
+        /**
+         * Starts receiving a message, without blocking.
+         *
+         * @param tag The tag identifying the kind of the message to read.
+         * @param src The identifier of the source of the message (i.e., the communicator that sent it).
+         *
+         * @return The request to use to retrieve the message once received.
+         */
+        INetworkRequest *irecv(int tag, int src) override;
+
+        /**
+         * Starts sending a message, without blocking.
+         *
+         * @param message The message to send, which is released once sent.
+         * @param dest The identifier of the destination of the message (i.e., the communicator that will receive it).
+         *
+         * @return The request to use to wait for the message to be sent.
+         */
+        INetworkRequest *isend(Message *message, int dest) override;
+
+        /**
+         * Finalizes the communication between the different communicators.
+         */
+        void finalize() override;
+
+    };
+
+}
+
+#endif
@@ -34,7 +34,9 @@
 
 #include <cstring>
 #include <functional>
+#include <vector>
 
+#include "INetworkRequest.hpp"
 #include "Message.hpp"
 
 namespace Panoramyx {
@@ -75,16 +77,30 @@ namespace Panoramyx {
          */
         virtual void start(std::function<void()> runnable) = 0;
 
+        /**
+         * Binds a runnable to the current communicator, so that it is identified as
+         * this communicator whatever the thread that executes it.
+         * This method must be used for the runnables executed by helper threads that
+         * communicate on behalf of the current communicator.
+         * By default, the runnable is returned unchanged.
+         *
+         * @param runnable The runnable to bind.
+         *
+         * @return The bound runnable.
+         */
+        virtual std::function<void()> attach(std::function<void()> runnable);
+
         /**
          * Receives a message.
+         * The returned message is allocated with exactly the size it needs, and
+         * must be released with MessagePool::release() (or by a MessageHandle).
          *
          * @param tag The tag identifying the kind of the message to read.
          * @param src The identifier of the source of the message (i.e., the communicator that sent it).
-         * @param size The maximum size of the message to read.
          *
          * @return The received message.
          */
-        virtual Message *receive(int tag, int src, unsigned long size = PANO_DEFAULT_MESSAGE_SIZE) = 0;
+        virtual Message *receive(int tag, int src) = 0;
 
         /**
          * Sends a message.
@@ -94,11 +110,106 @@ namespace Panoramyx {
          */
         virtual void send(Message *message, int dest) = 0;
 
+        /**
+         * Sends a message, transferring its ownership to this communication.
+         * This allows transports sharing the address space of the destination to
+         * deliver the message without copying it.
+         * The message must not be used by the caller anymore.
+         *
+         * @param message The message to send.
+         * @param dest The identifier of the destination of the message (i.e., the communicator that will receive it).
+         */
+        virtual void transfer(Message *message, int dest);
+
+        /**
+         * Starts receiving a message, without blocking.
+         *
+         * @param tag The tag identifying the kind of the message to read.
+         * @param src The identifier of the source of the message (i.e., the communicator that sent it).
+         *
+         * @return The request to use to retrieve the message once received.
+         *         It must be deleted by the caller.
+         */
+        virtual INetworkRequest *irecv(int tag, int src) = 0;
+
+        /**
+         * Starts sending a message, without blocking.
+         * The ownership of the message is transferred to the returned request,
+         * which releases the message once it has been sent.
+         * Messages sent to the same destination are delivered in the order in
+         * which they are sent, whether they are sent with send() or isend().
+         *
+         * @param message The message to send.
+         * @param dest The identifier of the destination of the message (i.e., the communicator that will receive it).
+         *
+         * @return The request to use to wait for the message to be sent.
+         *         It must be deleted by the caller.
+         */
+        virtual INetworkRequest *isend(Message *message, int dest) = 0;
+
+        /**
+         * Sends the same message to several communicators.
+         * By default, the message is propagated along a binomial tree: each
+         * communicator reached by the message forwards it (when it receives it) to
+         * half of the communicators it is responsible for, so that the message
+         * reaches all of them after a logarithmic number of hops.
+         * The received messages have the current communicator as source.
+         * The caller keeps the ownership of the message.
+         *
+         * Note that a broadcast message may be received before a message that has
+         * been sent earlier to the same destination with send() or isend().
+         *
+         * @param message The message to send.
+         * @param ranks The identifiers of the communicators that will receive the message.
+         */
+        virtual void broadcast(Message *message, const std::vector<int> &ranks);
+
+        /**
+         * Completes the reception of a message by the current communicator.
+         * If the message is part of a broadcast, it is forwarded to the communicators
+         * the current communicator is responsible for.
+         * This method must be called by the implementations on every message they
+         * receive, before giving it to their caller.
+         *
+         * @param message The received message (may be nullptr).
+         *
+         * @return The received message, as sent by the source of the broadcast.
+         */
+        Message *completeReceive(Message *message);
+
+        /**
+         * Waits until all the given requests have completed.
+         *
+         * @param requests The requests to wait for.
+         */
+        virtual void waitAll(const std::vector<INetworkRequest *> &requests);
+
+        /**
+         * Checks whether any of the given requests has completed, without blocking.
+         *
+         * @param requests The requests to check.
+         *
+         * @return The index of a completed request, or -1 if none has completed.
+         */
+        virtual int testAny(const std::vector<INetworkRequest *> &requests);
+
         /**
          * Finalizes the communication between the different communicators.
          */
         virtual void finalize()=0;
 
+    private:
+
+        /**
+         * Forwards a message along a binomial tree.
+         *
+         * @param message The message to forward.
+         * @param root The identifier of the communicator that has broadcast the message.
+         * @param ranks The identifiers of the communicators that must receive the message.
+         *        This vector is consumed by this method.
+         */
+        void forward(const Message *message, int root, std::vector<int> &ranks);
+
     };
 
 }
@@ -0,0 +1,79 @@
+/**
+ * PANORAMYX - Programming pArallel coNstraint sOlveRs mAde aMazingly easY.
+ * Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see {@link http://www.gnu.org/licenses}.
+ */
+
+/**
+ * @file INetworkRequest.hpp
+ * @brief Defines a handle on a pending non-blocking communication.
+ *
+ * @author Thibault Falque
+ * @author Romain Wallon
+ *
+ * @copyright Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#ifndef PANORAMYX_INETWORKREQUEST_HPP
+#define PANORAMYX_INETWORKREQUEST_HPP
+
+#include "Message.hpp"
+
+namespace Panoramyx {
+
+    /**
+     * The INetworkRequest defines an interface for handles on the non-blocking
+     * communications started by an INetworkCommunication.
+     * Destroying a request that has not completed yet waits for its completion.
+     */
+    class INetworkRequest {
+
+    public:
+
+        /**
+         * Destroys this INetworkRequest.
+         */
+        virtual ~INetworkRequest() = default;
+
+        /**
+         * Checks whether the communication has completed, without blocking.
+         *
+         * @return Whether the communication has completed.
+         */
+        virtual bool test() = 0;
+
+        /**
+         * Waits until the communication has completed.
+         */
+        virtual void wait() = 0;
+
+        /**
+         * Gives the message received by this request, if any.
+         * The ownership of the message is transferred to the caller, who must
+         * release it with MessagePool::release() (or a MessageHandle).
+         *
+         * @return The received message, or nullptr if this request is a send
+         *         request, has not completed yet, or has already given its message.
+         */
+        virtual Message *getMessage() = 0;
+
+    };
+
+}
+
+#endif
@@ -0,0 +1,273 @@
+/**
+ * PANORAMYX - Programming pArallel coNstraint sOlveRs mAde aMazingly easY.
+ * Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see {@link http://www.gnu.org/licenses}.
+ */
+
+/**
+ * @file InstrumentedNetworkCommunication.hpp
+ * @brief Provides a communication recording metrics about the messages exchanged by another communication.
+ *
+ * @author Thibault Falque
+ * @author Romain Wallon
+ *
+ * @copyright Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#ifndef PANORAMYX_INSTRUMENTEDNETWORKCOMMUNICATION_HPP
+#define PANORAMYX_INSTRUMENTEDNETWORKCOMMUNICATION_HPP
+
+#include <array>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <tuple>
+
+#include "NetworkCommunicationDecorator.hpp"
+
+/**
+ * The number of buckets in the latency histograms.
+ * The i-th bucket counts the operations that took between 2^(i-1) and 2^i microseconds.
+ */
+#define PANO_LATENCY_BUCKETS 28
+
+namespace Panoramyx {
+
+    /**
+     * The InstrumentedNetworkCommunication records metrics about the messages exchanged
+     * through the decorated communication: the number of messages and bytes, and the
+     * latency of the operations, per opcode and tag and per peer, as well as the time
+     * spent blocked waiting for messages.
+     * Broadcasts are recorded as separate operations by their root, as the messages
+     * relaying them along the broadcast tree are sent by the decorated communication.
+     * The communicators receiving a broadcast message record it as received from the
+     * root of the broadcast, without the data describing the tree.
+     * A JSON report of these metrics is written when the communication is finalized.
+     */
+    class InstrumentedNetworkCommunication : public Panoramyx::NetworkCommunicationDecorator {
+
+    public:
+
+        /**
+         * The LatencyHistogram records the durations of a kind of operations.
+         */
+        struct LatencyHistogram {
+
+            /**
+             * The total duration of the operations, in microseconds.
+             */
+            unsigned long totalMicros = 0;
+
+            /**
+             * The longest duration of an operation, in microseconds.
+             */
+            unsigned long maxMicros = 0;
+
+            /**
+             * The number of operations in each bucket.
+             */
+            std::array<unsigned long, PANO_LATENCY_BUCKETS> buckets = {};
+
+            /**
+             * Records the duration of an operation.
+             *
+             * @param micros The duration of the operation, in microseconds.
+             */
+            void record(unsigned long micros);
+
+        };
+
+        /**
+         * The TrafficStatistics records the messages of a given kind.
+         */
+        struct TrafficStatistics {
+
+            /**
+             * The number of messages.
+             */
+            unsigned long count = 0;
+
+            /**
+             * The number of bytes of the messages (headers included).
+             */
+            unsigned long bytes = 0;
+
+            /**
+             * The latency of the operations on the messages.
+             */
+            LatencyHistogram latency;
+
+        };
+
+        /**
+         * The BroadcastStatistics records the broadcasts of a given kind of messages.
+         */
+        struct BroadcastStatistics : TrafficStatistics {
+
+            /**
+             * The total number of communicators the messages have been broadcast to.
+             */
+            unsigned long recipients = 0;
+
+        };
+
+    private:
+
+        /**
+         * The path of the file in which to write the report.
+         */
+        std::string reportFile;
+
+        /**
+         * The mutex protecting the statistics, which may be updated by several threads.
+         */
+        std::mutex statisticsMutex;
+
+        /**
+         * The statistics about the messages, indexed by communicator, direction (true
+         * for sent messages), opcode and tag.
+         */
+        std::map<std::tuple<int, bool, MessageOpcode, int>, TrafficStatistics> messageStatistics;
+
+        /**
+         * The statistics about the messages, indexed by communicator, direction (true
+         * for sent messages) and peer.
+         */
+        std::map<std::tuple<int, bool, int>, TrafficStatistics> peerStatistics;
+
+        /**
+         * The statistics about the broadcast messages, indexed by communicator (the root
+         * of the broadcasts), opcode and tag.
+         */
+        std::map<std::tuple<int, MessageOpcode, int>, BroadcastStatistics> broadcastStatistics;
+
+        /**
+         * The time spent blocked waiting for messages, indexed by communicator.
+         */
+        std::map<int, LatencyHistogram> blockedStatistics;
+
+    public:
+
+        /**
+         * Creates a new InstrumentedNetworkCommunication.
+         *
+         * @param decorated The communication to decorate.
+         * @param reportFile The prefix of the path of the file in which to write the report
+         *        (the identifier of the communicator and the extension are appended to it).
+         */
+        InstrumentedNetworkCommunication(Panoramyx::INetworkCommunication *decorated, std::string reportFile);
+
+        /**
+         * Receives a message, measuring the time spent waiting for it.
+         *
+         * @param tag The tag identifying the kind of the message to read.
+         * @param src The identifier of the source of the message.
+         *
+         * @return The received message.
+         */
+        Message *receive(int tag, int src) override;
+
+        /**
+         * Sends a message, measuring the time needed to send it.
+         *
+         * @param message The message to send.
+         * @param dest The identifier of the destination of the message.
+         */
+        void send(Message *message, int dest) override;
+
+        /**
+         * Sends a message, transferring its ownership to this communication, and
+         * measuring the time needed to send it.
+         *
+         * @param message The message to send.
+         * @param dest The identifier of the destination of the message.
+         */
+        void transfer(Message *message, int dest) override;
+
+        /**
+         * Starts receiving a message, without blocking.
+         * The message is recorded when it is retrieved from the request.
+         *
+         * @param tag The tag identifying the kind of the message to read.
+         * @param src The identifier of the source of the message.
+         *
+         * @return The request to use to retrieve the message once received.
+         */
+        INetworkRequest *irecv(int tag, int src) override;
+
+        /**
+         * Starts sending a message, without blocking, and measures the time needed to post it.
+         *
+         * @param message The message to send.
+         * @param dest The identifier of the destination of the message.
+         *
+         * @return The request to use to wait for the message to be sent.
+         */
+        INetworkRequest *isend(Message *message, int dest) override;
+
+        /**
+         * Sends the same message to several communicators, and measures the time needed to do so.
+         * The broadcast is recorded as a single operation, with the number of recipients.
+         *
+         * @param message The message to send.
+         * @param ranks The identifiers of the communicators that will receive the message.
+         */
+        void broadcast(Message *message, const std::vector<int> &ranks) override;
+
+        /**
+         * Writes the report, and finalizes the decorated communication.
+         */
+        void finalize() override;
+
+        /**
+         * Records a message that has been received by the current communicator.
+         *
+         * @param message The received message.
+         * @param latencyMicros The time elapsed between the start of the reception and its
+         *        completion, in microseconds.
+         * @param blockedMicros The time spent blocked waiting for the message, in microseconds.
+         */
+        void recordReceived(const Message *message, unsigned long latencyMicros, unsigned long blockedMicros);
+
+        /**
+         * Writes the report of the recorded metrics in JSON.
+         *
+         * @param output The stream to write the report to.
+         */
+        void writeReport(std::ostream &output);
+
+    private:
+
+        /**
+         * Records a message.
+         *
+         * @param sent Whether the message has been sent (or received).
+         * @param opcode The opcode of the message.
+         * @param tag The tag of the message.
+         * @param bytes The size of the message, in bytes.
+         * @param peer The identifier of the communicator the message has been exchanged with.
+         * @param micros The duration of the operation, in microseconds.
+         */
+        void record(bool sent, MessageOpcode opcode, int tag, unsigned long bytes, int peer, unsigned long micros);
+
+    };
+
+}
+
+#endif
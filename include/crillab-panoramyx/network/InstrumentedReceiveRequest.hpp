@@ -0,0 +1,129 @@
+/**
+ * PANORAMYX - Programming pArallel coNstraint sOlveRs mAde aMazingly easY.
+ * Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see {@link http://www.gnu.org/licenses}.
+ */
+
+/**
+ * @file InstrumentedReceiveRequest.hpp
+ * @brief Represents a message being received by an InstrumentedNetworkCommunication.
+ *
+ * @author Thibault Falque
+ * @author Romain Wallon
+ *
+ * @copyright Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#ifndef PANORAMYX_INSTRUMENTEDRECEIVEREQUEST_HPP
+#define PANORAMYX_INSTRUMENTEDRECEIVEREQUEST_HPP
+
+#include <chrono>
+
+#include "INetworkRequest.hpp"
+
+namespace Panoramyx {
+
+    class InstrumentedNetworkCommunication;
+
+    /**
+     * The InstrumentedReceiveRequest wraps a receive request of the decorated
+     * communication, so as to measure the time needed to receive the message, and
+     * the time spent blocked waiting for it.
+     */
+    class InstrumentedReceiveRequest : public Panoramyx::INetworkRequest {
+
+    private:
+
+        /**
+         * The communication recording the metrics.
+         */
+        Panoramyx::InstrumentedNetworkCommunication *communication;
+
+        /**
+         * The request receiving the message.
+         */
+        Panoramyx::INetworkRequest *request;
+
+        /**
+         * The time at which the reception has started.
+         */
+        std::chrono::steady_clock::time_point start;
+
+        /**
+         * The time elapsed between the start and the completion of the reception, in microseconds.
+         */
+        unsigned long latencyMicros;
+
+        /**
+         * The time spent blocked in wait(), in microseconds.
+         */
+        unsigned long blockedMicros;
+
+        /**
+         * Whether the completion of the reception has been observed.
+         */
+        bool completed;
+
+    public:
+
+        /**
+         * Creates a new InstrumentedReceiveRequest.
+         *
+         * @param communication The communication recording the metrics.
+         * @param request The request receiving the message.
+         *        Its ownership is transferred to this request.
+         */
+        InstrumentedReceiveRequest(Panoramyx::InstrumentedNetworkCommunication *communication,
+                                   Panoramyx::INetworkRequest *request);
+
+        /**
+         * Destroys this InstrumentedReceiveRequest, and the wrapped request.
+         */
+        ~InstrumentedReceiveRequest() override;
+
+        /**
+         * Checks whether the message has been received, without blocking.
+         *
+         * @return Whether the message has been received.
+         */
+        bool test() override;
+
+        /**
+         * Waits until the message has been received.
+         */
+        void wait() override;
+
+        /**
+         * Gives the received message, and records it.
+         *
+         * @return The received message, or nullptr.
+         */
+        Message *getMessage() override;
+
+    private:
+
+        /**
+         * Records the completion of the reception, if not done yet.
+         */
+        void complete();
+
+    };
+
+}
+
+#endif
@@ -32,6 +32,10 @@
 #ifndef PANORAMYX_MPINETWORKCOMMUNICATION_HPP
 #define PANORAMYX_MPINETWORKCOMMUNICATION_HPP
 
+#include <mutex>
+
+#include <mpi.h>
+
 #include "INetworkCommunication.hpp"
 
 namespace Panoramyx {
@@ -40,6 +44,14 @@ namespace Panoramyx {
      * The MPINetworkCommunication is an implementation of INetworkCommunication
      * that relies on MPI (Message Passing Interface) to communicate between
      * different processes.
+     * Messages are received with the exact size they need, as given by MPI_Mprobe.
+     * Messages that are larger than the chunk size are split into a first part
+     * sent on MPI_COMM_WORLD and chunks sent on a dedicated communicator, so that
+     * no single MPI transfer exceeds the chunk size.
+     * The chunks are only identified by the source and the tag of their message.
+     * The messages from a given source with a given tag must thus be received by
+     * one thread at a time (as done by ResponseDispatcher), or the threads may take
+     * the chunks of each other.
      */
     class MPINetworkCommunication : public Panoramyx::INetworkCommunication {
 
@@ -60,6 +72,45 @@ namespace Panoramyx {
          */
         int worldSize = -1;
 
+        /**
+         * The communicator on which the chunks of large messages are sent.
+         */
+        MPI_Comm chunkCommunicator;
+
+        /**
+         * The maximum number of bytes sent in a single MPI transfer.
+         */
+        unsigned long chunkSize;
+
+        /**
+         * The mutex ensuring that the chunks of different messages are not interleaved.
+         */
+        std::mutex chunkMutex;
+
+        /**
+         * Creates a new MPINetworkCommunication.
+         *
+         * @param chunkSize The maximum number of bytes sent in a single MPI transfer.
+         */
+        explicit MPINetworkCommunication(unsigned long chunkSize);
+
+        /**
+         * Receives a message that has already been matched by MPI.
+         * No other thread may receive a message with the same source and tag until
+         * this method returns, as the chunks of the message are not matched yet.
+         *
+         * @param handle The handle of the matched message.
+         * @param status The status of the matched message.
+         *
+         * @return The received message.
+         */
+        Message *receive(MPI_Message &handle, MPI_Status &status);
+
+        /**
+         * The MPIReceiveRequest receives the messages it has matched.
+         */
+        friend class MPIReceiveRequest;
+
     public:
 
         /**
@@ -69,10 +120,15 @@ namespace Panoramyx {
 
         /**
          * Gives the unique instance of MPINetworkCommunication.
+         * This method must be called by all processes, right after MPI has been
+         * initialized.
+         *
+         * @param chunkSize The maximum number of bytes sent in a single MPI transfer.
+         *        This parameter is only considered when the instance is created.
          *
          * @return The unique instance of MPINetworkCommunication.
          */
-        static INetworkCommunication *getInstance();
+        static INetworkCommunication *getInstance(unsigned long chunkSize = PANO_DEFAULT_CHUNK_SIZE);
 
         /**
          * Gives the identifier of the current communicator.
@@ -97,14 +153,17 @@ namespace Panoramyx {
 
         /**
          * Receives a message.
+         * The returned message is allocated with exactly the size it needs, and
+         * must be released with MessagePool::release() (or by a MessageHandle).
+         * Messages from the same source with the same tag must not be received by
+         * several threads at the same time (see the documentation of this class).
          *
          * @param tag The tag identifying the kind of the message to read.
          * @param src The identifier of the source of the message (i.e., the communicator that sent it).
-         * @param size The maximum size of the message to read.
          *
          * @return The received message.
          */
-        Message *receive(int tag, int src, unsigned long size) override;
+        Message *receive(int tag, int src) override;
 
         /**
          * Sends a message.
@@ -114,6 +173,26 @@ namespace Panoramyx {
          */
         void send(Message *message, int dest) override;
 
+        /**
+         * Starts receiving a message, without blocking.
+         *
+         * @param tag The tag identifying the kind of the message to read.
+         * @param src The identifier of the source of the message (i.e., the communicator that sent it).
+         *
+         * @return The request to use to retrieve the message once received.
+         */
+        INetworkRequest *irecv(int tag, int src) override;
+
+        /**
+         * Starts sending a message, without blocking.
+         *
+         * @param message The message to send, which is released once sent.
+         * @param dest The identifier of the destination of the message (i.e., the communicator that will receive it).
+         *
+         * @return The request to use to wait for the message to be sent.
+         */
+        INetworkRequest *isend(Message *message, int dest) override;
+
         /**
          * Finalizes the communication between the different communicators.
          */
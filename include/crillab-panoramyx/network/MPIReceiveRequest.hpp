@@ -0,0 +1,120 @@
+/**
+ * PANORAMYX - Programming pArallel coNstraint sOlveRs mAde aMazingly easY.
+ * Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see {@link http://www.gnu.org/licenses}.
+ */
+
+/**
+ * @file MPIReceiveRequest.hpp
+ * @brief A pending non-blocking receive performed with MPI.
+ *
+ * @author Thibault Falque
+ * @author Romain Wallon
+ *
+ * @copyright Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#ifndef PANORAMYX_MPIRECEIVEREQUEST_HPP
+#define PANORAMYX_MPIRECEIVEREQUEST_HPP
+
+#include "INetworkRequest.hpp"
+
+namespace Panoramyx {
+
+    /**
+     * Forward declaration of MPINetworkCommunication.
+     */
+    class MPINetworkCommunication;
+
+    /**
+     * The MPIReceiveRequest represents a message to be received with MPI.
+     * As the size of the message is not known in advance, the message is
+     * matched with MPI_Improbe (or MPI_Mprobe when waiting) and then received
+     * with its exact size.
+     */
+    class MPIReceiveRequest : public Panoramyx::INetworkRequest {
+
+    private:
+
+        /**
+         * The communication used to receive the message.
+         */
+        Panoramyx::MPINetworkCommunication *communication;
+
+        /**
+         * The tag identifying the kind of the message to read.
+         */
+        int tag;
+
+        /**
+         * The identifier of the source of the message.
+         */
+        int src;
+
+        /**
+         * Whether the message has been received.
+         */
+        bool completed;
+
+        /**
+         * The received message, until it is retrieved.
+         */
+        Message *message;
+
+    public:
+
+        /**
+         * Creates a new MPIReceiveRequest.
+         *
+         * @param communication The communication used to receive the message.
+         * @param tag The tag identifying the kind of the message to read.
+         * @param src The identifier of the source of the message.
+         */
+        MPIReceiveRequest(Panoramyx::MPINetworkCommunication *communication, int tag, int src);
+
+        /**
+         * Destroys this MPIReceiveRequest.
+         * The received message is released if it has not been retrieved.
+         * A message that has not been matched yet is left to other receives.
+         */
+        ~MPIReceiveRequest() override;
+
+        /**
+         * Checks whether the message has been received, without blocking.
+         *
+         * @return Whether the message has been received.
+         */
+        bool test() override;
+
+        /**
+         * Waits until the message has been received.
+         */
+        void wait() override;
+
+        /**
+         * Gives the received message.
+         *
+         * @return The received message, or nullptr.
+         */
+        Message *getMessage() override;
+
+    };
+
+}
+
+#endif
@@ -0,0 +1,97 @@
+/**
+ * PANORAMYX - Programming pArallel coNstraint sOlveRs mAde aMazingly easY.
+ * Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see {@link http://www.gnu.org/licenses}.
+ */
+
+/**
+ * @file MPISendRequest.hpp
+ * @brief A pending non-blocking send performed with MPI.
+ *
+ * @author Thibault Falque
+ * @author Romain Wallon
+ *
+ * @copyright Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#ifndef PANORAMYX_MPISENDREQUEST_HPP
+#define PANORAMYX_MPISENDREQUEST_HPP
+
+#include <mpi.h>
+
+#include "INetworkRequest.hpp"
+
+namespace Panoramyx {
+
+    /**
+     * The MPISendRequest wraps the MPI request of a message sent with MPI_Isend.
+     * The request owns the message, which is released once the send has completed.
+     */
+    class MPISendRequest : public Panoramyx::INetworkRequest {
+
+    private:
+
+        /**
+         * The underlying MPI request.
+         */
+        MPI_Request request;
+
+        /**
+         * The message being sent, or nullptr once the send has completed.
+         */
+        Message *message;
+
+    public:
+
+        /**
+         * Creates a new MPISendRequest.
+         *
+         * @param request The underlying MPI request.
+         * @param message The message being sent.
+         */
+        MPISendRequest(MPI_Request request, Message *message);
+
+        /**
+         * Destroys this MPISendRequest, waiting for the send to complete.
+         */
+        ~MPISendRequest() override;
+
+        /**
+         * Checks whether the message has been sent, without blocking.
+         *
+         * @return Whether the message has been sent.
+         */
+        bool test() override;
+
+        /**
+         * Waits until the message has been sent.
+         */
+        void wait() override;
+
+        /**
+         * Gives the message received by this request.
+         *
+         * @return Always nullptr, as this is a send request.
+         */
+        Message *getMessage() override;
+
+    };
+
+}
+
+#endif
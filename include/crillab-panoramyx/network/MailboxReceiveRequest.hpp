@@ -0,0 +1,121 @@
+/**
+ * PANORAMYX - Programming pArallel coNstraint sOlveRs mAde aMazingly easY.
+ * Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see {@link http://www.gnu.org/licenses}.
+ */
+
+/**
+ * @file MailboxReceiveRequest.hpp
+ * @brief A pending non-blocking receive from a message mailbox.
+ *
+ * @author Thibault Falque
+ * @author Romain Wallon
+ *
+ * @copyright Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#ifndef PANORAMYX_MAILBOXRECEIVEREQUEST_HPP
+#define PANORAMYX_MAILBOXRECEIVEREQUEST_HPP
+
+#include "INetworkCommunication.hpp"
+#include "INetworkRequest.hpp"
+#include "MessageMailbox.hpp"
+
+namespace Panoramyx {
+
+    /**
+     * The MailboxReceiveRequest represents a message to be read from the mailbox
+     * in which messages are delivered to a communicator.
+     */
+    class MailboxReceiveRequest : public Panoramyx::INetworkRequest {
+
+    private:
+
+        /**
+         * The communication owning the mailbox.
+         */
+        Panoramyx::INetworkCommunication *communication;
+
+        /**
+         * The mailbox from which the message is read.
+         */
+        Panoramyx::MessageMailbox *mailbox;
+
+        /**
+         * The tag identifying the kind of the message to read.
+         */
+        int tag;
+
+        /**
+         * The identifier of the source of the message.
+         */
+        int src;
+
+        /**
+         * Whether the message has been received.
+         */
+        bool completed;
+
+        /**
+         * The received message, until it is retrieved.
+         */
+        Message *message;
+
+    public:
+
+        /**
+         * Creates a new MailboxReceiveRequest.
+         *
+         * @param communication The communication owning the mailbox.
+         * @param mailbox The mailbox from which the message is read.
+         * @param tag The tag identifying the kind of the message to read.
+         * @param src The identifier of the source of the message.
+         */
+        MailboxReceiveRequest(Panoramyx::INetworkCommunication *communication,
+                              Panoramyx::MessageMailbox *mailbox, int tag, int src);
+
+        /**
+         * Destroys this MailboxReceiveRequest.
+         * The received message is released if it has not been retrieved.
+         */
+        ~MailboxReceiveRequest() override;
+
+        /**
+         * Checks whether the message has been received, without blocking.
+         *
+         * @return Whether the message has been received.
+         */
+        bool test() override;
+
+        /**
+         * Waits until the message has been received.
+         */
+        void wait() override;
+
+        /**
+         * Gives the received message.
+         *
+         * @return The received message, or nullptr.
+         */
+        Message *getMessage() override;
+
+    };
+
+}
+
+#endif
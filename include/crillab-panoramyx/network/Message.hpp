@@ -32,7 +32,7 @@
 #ifndef PANORAMYX_MESSAGE_HPP
 #define PANORAMYX_MESSAGE_HPP
 
-#include <cstring>
+#include "MessageOpcode.hpp"
 
 #define PANO_ANY_SOURCE (-1)
 
@@ -41,59 +41,22 @@
 #define PANO_TAG_SOLVE 2
 #define PANO_TAG_CONFIG 4
 
-#define PANO_DEFAULT_MESSAGE_SIZE 1024
+#define PANO_DEFAULT_CHUNK_SIZE (1UL << 20)
+#define PANO_DEFAULT_RING_SIZE (1UL << 18)
 #define PANO_NUMBER_MAX_CHAR 20
 #define PANO_VARIABLE_NAME_MAX_CHAR 20
 
-#define PANO_MESSAGE_CONSTRAINT_SET_IGNORED "igr"
-#define PANO_MESSAGE_CONSTRAINT_IS_IGNORED "ig?"
-#define PANO_MESSAGE_CONSTRAINT_SCORE "scr"
-
-#define PANO_MESSAGE_INDEX "idx"
-#define PANO_MESSAGE_RESET "rst"
-#define PANO_MESSAGE_N_VARIABLES "nv"
-#define PANO_MESSAGE_GET_VARIABLES_MAPPING "vmp"
-#define PANO_MESSAGE_GET_AUXILIARY_VARIABLES "aux"
-#define PANO_MESSAGE_GET_CONSTRAINTS "ctr"
-#define PANO_MESSAGE_DECISION_VARIABLES "dec"
-#define PANO_MESSAGE_VALUE_HEURISTIC_STATIC "vhs"
-#define PANO_MESSAGE_N_CONSTRAINTS "nc"
-#define PANO_MESSAGE_IS_OPTIMIZATION "op?"
-#define PANO_MESSAGE_IS_MINIMIZATION "min"
-#define PANO_MESSAGE_SET_TIMEOUT "t"
-#define PANO_MESSAGE_SET_TIMEOUT_MS "tm"
-#define PANO_MESSAGE_SET_VERBOSITY "v"
-#define PANO_MESSAGE_ADD_SEARCH_LISTENER "adl"
-#define PANO_MESSAGE_SET_LOG_FILE "log"
-#define PANO_MESSAGE_SET_LOG_STREAM "lgs"
-#define PANO_MESSAGE_LOAD_INSTANCE "lod"
-#define PANO_MESSAGE_SOLVE "s"
-#define PANO_MESSAGE_SOLVE_FILENAME "sf"
-#define PANO_MESSAGE_SOLVE_ASSUMPTIONS "sa"
-#define PANO_MESSAGE_INTERRUPT "i"
-#define PANO_MESSAGE_SOLUTION "sol"
-#define PANO_MESSAGE_MAP_SOLUTION "map"
-#define PANO_MESSAGE_CHECK_SOLUTION "chk"
-#define PANO_MESSAGE_CHECK_SOLUTION_ASSIGNMENT "cka"
-#define PANO_MESSAGE_END_SEARCH "end"
-#define PANO_MESSAGE_END_SEARCH_ACK "eck"
-
-#define PANO_MESSAGE_SATISFIABLE "sat"
-#define PANO_MESSAGE_UNSATISFIABLE "ust"
-#define PANO_MESSAGE_OPTIMUM_FOUND "opt"
-#define PANO_MESSAGE_UNSUPPORTED "usp"
-#define PANO_MESSAGE_UNKNOWN "unk"
-
-#define PANO_MESSAGE_LOWER_BOUND "low"
-#define PANO_MESSAGE_UPPER_BOUND "upp"
-#define PANO_MESSAGE_LOWER_UPPER_BOUND "lub"
-#define PANO_MESSAGE_GET_CURRENT_BOUND "cur"
-#define PANO_MESSAGE_GET_LOWER_BOUND "lb?"
-#define PANO_MESSAGE_GET_UPPER_BOUND "ub?"
-#define PANO_MESSAGE_NEW_BOUND_FOUND "bnd"
-
-#define IS(str) (str)
-#define NAME_OF(msg, n) (strncmp((msg)->name, (n), sizeof((msg)->name)) == 0)
+#define PANO_DEFAULT_COMPRESSION_THRESHOLD (1UL << 16)
+#define PANO_DEFAULT_SOLUTION_ATTACHMENT_LIMIT (1UL << 16)
+
+#define PANO_FLAG_COMPRESSED 1
+#define PANO_FLAG_BROADCAST 2
+#define PANO_FLAG_SOLUTION 4
+
+#define PANO_CAPABILITY_INCREMENTAL 1
+
+#define PANO_BIG_INTEGER_SMALL 0
+#define PANO_BIG_INTEGER_DECIMAL 1
 
 namespace Panoramyx {
 
@@ -123,9 +86,20 @@ namespace Panoramyx {
         int tag;
 
         /**
-         * The name of this message.
+         * The version of the protocol used to build this message.
+         */
+        unsigned char version;
+
+        /**
+         * The opcode identifying the operation requested by this message.
          */
-        char name[4];
+        MessageOpcode opcode;
+
+        /**
+         * The flags describing how the parameters of this message are encoded
+         * (e.g., PANO_FLAG_COMPRESSED), or what they contain (e.g., PANO_FLAG_SOLUTION).
+         */
+        unsigned char flags;
 
         /**
          * The source of the message (i.e., the identifier of the communicator that has sent it).
@@ -137,6 +111,13 @@ namespace Panoramyx {
          */
         int nbParameters;
 
+        /**
+         * The identifier of the request this message is part of, which is copied in the
+         * response to this request so that the response can be matched with it.
+         * It is 0 for the messages that do not expect a response.
+         */
+        unsigned int requestId;
+
         /**
          * The size of the parameters of this message.
          */
@@ -33,7 +33,10 @@
 #define PANORAMYX_MESSAGEBUILDER_HPP
 
 #include <cstring>
+#include <istream>
 #include <string>
+#include <string_view>
+#include <vector>
 
 #include <crillab-universe/core/UniverseType.hpp>
 
@@ -55,25 +58,38 @@ namespace Panoramyx {
         Message *message;
 
         /**
-         * The (full) size of the message that is being built.
+         * The number of bytes that can be stored in the message that is being built.
          */
-        unsigned long size;
+        unsigned long capacity;
 
     public:
 
         /**
          * Creates a new MessageBuilder.
+         * The message is allocated from the MessagePool.
          */
         MessageBuilder();
 
         /**
-         * Specifies the name of the message that is being built.
+         * Ensures that the message that is being built can store the given number of
+         * additional bytes of parameters without being reallocated.
+         * This should be used when the final size of the message is known (or can be
+         * estimated) before adding its parameters.
          *
-         * @param name The name of the message.
+         * @param parametersSize The number of bytes of parameters that are about to be added.
          *
          * @return This message builder.
          */
-        MessageBuilder &named(const std::string &name);
+        MessageBuilder &reserve(unsigned long parametersSize);
+
+        /**
+         * Specifies the opcode of the message that is being built.
+         *
+         * @param opcode The opcode of the message.
+         *
+         * @return This message builder.
+         */
+        MessageBuilder &withOpcode(MessageOpcode opcode);
 
         /**
          * Specifies the source of the message that is being built.
@@ -94,6 +110,34 @@ namespace Panoramyx {
          */
         MessageBuilder &withTag(int tag);
 
+        /**
+         * Specifies the identifier of the request the message that is being built is part of.
+         *
+         * @param requestId The identifier of the request.
+         *
+         * @return This message builder.
+         */
+        MessageBuilder &withRequestId(unsigned int requestId);
+
+        /**
+         * Specifies that the message that is being built is the response to the given request.
+         * The message is tagged as a response, and the identifier of the request is copied.
+         *
+         * @param request The message to which the message that is being built responds.
+         *
+         * @return This message builder.
+         */
+        MessageBuilder &inResponseTo(const Message *request);
+
+        /**
+         * Adds flags to the message that is being built.
+         *
+         * @param flags The flags to add (e.g., PANO_FLAG_SOLUTION).
+         *
+         * @return This message builder.
+         */
+        MessageBuilder &withFlags(unsigned char flags);
+
         /**
          * Adds a parameter to the message that is being built.
          *
@@ -106,15 +150,13 @@ namespace Panoramyx {
         template<typename T>
         MessageBuilder &withParameter(T param) {
             message->nbParameters++;
-            size += sizeof(T);
-            message = static_cast<Message *>(realloc(message, size));
-            memcpy(message->parameters + message->size, &param, sizeof(param));
-            message->size += sizeof(T);
+            append(&param, sizeof(T));
             return *this;
         }
 
         /**
          * Adds a string parameter to the message that is being built.
+         * The string is stored with its terminating NUL character.
          *
          * @param param The parameter to add to the message.
          *
@@ -124,6 +166,7 @@ namespace Panoramyx {
 
         /**
          * Adds a big integer parameter to the message that is being built.
+         * The parameter is encoded as by withBigInteger().
          *
          * @param param The parameter to add to the message.
          *
@@ -131,13 +174,114 @@ namespace Panoramyx {
          */
         MessageBuilder &withParameter(Universe::BigInteger param);
 
+        /**
+         * Adds an unsigned integer parameter to the message that is being built.
+         * The parameter is encoded as a varint, i.e., using 7 bits per byte, the
+         * most significant bit telling whether more bytes follow.
+         * This encoding is also the one used for counts and lengths.
+         *
+         * @param param The parameter to add to the message.
+         *
+         * @return This message builder.
+         */
+        MessageBuilder &withUnsigned(unsigned long long param);
+
+        /**
+         * Adds a signed integer parameter to the message that is being built.
+         * The parameter is zig-zag encoded before being written as a varint, so that
+         * small negative values remain short.
+         *
+         * @param param The parameter to add to the message.
+         *
+         * @return This message builder.
+         */
+        MessageBuilder &withInteger(long long param);
+
+        /**
+         * Adds a length-prefixed string parameter to the message that is being built.
+         *
+         * @param param The parameter to add to the message.
+         *
+         * @return This message builder.
+         */
+        MessageBuilder &withString(std::string_view param);
+
+        /**
+         * Adds a length-prefixed string parameter to the message that is being built,
+         * reading its content directly from a stream.
+         * The parameter can be read back with MessageReader::readString().
+         *
+         * @param input The stream to read the parameter from.
+         * @param length The number of bytes to read from the stream.
+         *
+         * @return This message builder.
+         *
+         * @throws IllegalStateException If the stream does not contain enough bytes.
+         */
+        MessageBuilder &withStream(std::istream &input, unsigned long length);
+
+        /**
+         * Adds a big integer parameter to the message that is being built.
+         * The value is preceded by a tag: values fitting in a machine integer are
+         * written as zig-zag varints, other values are written as length-prefixed
+         * decimal strings.
+         *
+         * @param param The parameter to add to the message.
+         *
+         * @return This message builder.
+         */
+        MessageBuilder &withBigInteger(const Universe::BigInteger &param);
+
+        /**
+         * Adds a whole message as a parameter of the message that is being built.
+         * The embedded message (header included) is written as a length-prefixed
+         * sequence of bytes.
+         *
+         * @param param The message to embed.
+         *
+         * @return This message builder.
+         */
+        MessageBuilder &withMessage(const Message *param);
+
+        /**
+         * Adds a list of indices to the message that is being built.
+         * The list is written as ranges of consecutive indices, so that a range of
+         * indices takes a few bytes whatever its length.
+         *
+         * @param param The indices to add.
+         *
+         * @return This message builder.
+         */
+        MessageBuilder &withIndices(const std::vector<int> &param);
+
         /**
          * Builds the message.
+         * The caller becomes the owner of the built message, which must be released with
+         * MessagePool::release() (or owned by a MessageHandle).
          *
          * @return The message to send.
          */
         Message *build();
 
+    private:
+
+        /**
+         * Appends raw bytes at the end of the parameters of the message that is being built.
+         * The number of parameters is not updated by this method.
+         *
+         * @param data The bytes to append.
+         * @param length The number of bytes to append.
+         */
+        void append(const void *data, unsigned long length);
+
+        /**
+         * Appends a varint at the end of the parameters of the message that is being built.
+         * The number of parameters is not updated by this method.
+         *
+         * @param value The value to append.
+         */
+        void appendVarint(unsigned long long value);
+
     };
 
 }
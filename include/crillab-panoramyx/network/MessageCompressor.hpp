@@ -0,0 +1,100 @@
+/**
+ * PANORAMYX - Programming pArallel coNstraint sOlveRs mAde aMazingly easY.
+ * Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see {@link http://www.gnu.org/licenses}.
+ */
+
+/**
+ * @file MessageCompressor.hpp
+ * @brief Provides a fast LZ77 codec for the parameters of messages.
+ *
+ * @author Thibault Falque
+ * @author Romain Wallon
+ *
+ * @copyright Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#ifndef PANORAMYX_MESSAGECOMPRESSOR_HPP
+#define PANORAMYX_MESSAGECOMPRESSOR_HPP
+
+#include "Message.hpp"
+
+/**
+ * The binary logarithm of the number of entries in the hash table used to find matches.
+ */
+#define PANO_COMPRESSION_HASH_LOG 14
+
+/**
+ * The maximum distance between a sequence of bytes and its previous occurrence.
+ */
+#define PANO_COMPRESSION_WINDOW_SIZE 65535
+
+namespace Panoramyx {
+
+    /**
+     * The MessageCompressor compresses and decompresses the parameters of messages.
+     * It implements a greedy LZ77 codec (in the spirit of LZ4), which favors speed
+     * over compression ratio: it is meant to shrink the large and highly repetitive
+     * messages (such as solutions) sent by the solvers, not to archive data.
+     *
+     * The parameters of a compressed message start with the size of the original
+     * parameters (as an unsigned long), followed by a sequence of blocks, each
+     * made of a token, literal bytes, and a back-reference to a previous occurrence
+     * of the following bytes.
+     */
+    class MessageCompressor {
+
+    public:
+
+        /**
+         * Compresses the parameters of a message.
+         * The header of the message is preserved, and PANO_FLAG_COMPRESSED is set in
+         * the flags of the compressed message.
+         *
+         * @param message The message to compress.
+         *
+         * @return The compressed message, allocated by the MessagePool, or nullptr if
+         *         compression does not make the message smaller.
+         */
+        static Message *compress(const Message *message);
+
+        /**
+         * Decompresses a message that has been compressed with compress().
+         *
+         * @param message The message to decompress.
+         *
+         * @return The decompressed message, allocated by the MessagePool.
+         *
+         * @throws IllegalStateException If the message is not a valid compressed message.
+         */
+        static Message *decompress(const Message *message);
+
+        /**
+         * Checks whether a message is compressed.
+         *
+         * @param message The message to check.
+         *
+         * @return Whether the message is compressed.
+         */
+        static bool isCompressed(const Message *message);
+
+    };
+
+}
+
+#endif
@@ -0,0 +1,154 @@
+/**
+ * PANORAMYX - Programming pArallel coNstraint sOlveRs mAde aMazingly easY.
+ * Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see {@link http://www.gnu.org/licenses}.
+ */
+
+/**
+ * @file MessageDispatcher.hpp
+ * @brief Provides a table associating each opcode with the function handling the corresponding messages.
+ *
+ * @author Thibault Falque
+ * @author Romain Wallon
+ *
+ * @copyright Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#ifndef PANORAMYX_MESSAGEDISPATCHER_HPP
+#define PANORAMYX_MESSAGEDISPATCHER_HPP
+
+#include <array>
+
+#include "Message.hpp"
+
+namespace Panoramyx {
+
+    /**
+     * Reports that a message could not be dispatched, either because it has been
+     * built with another version of the protocol or because no handler is
+     * associated with its opcode.
+     *
+     * @param owner The name of the object that has received the message.
+     * @param message The message that could not be dispatched.
+     */
+    void reportUndispatchedMessage(const char *owner, const Message *message);
+
+    /**
+     * The MessageDispatcher is a jump table associating each opcode with the function
+     * handling the messages having this opcode.
+     * Dispatchers are meant to be built once (typically as static variables) and then
+     * shared by all the instances of the class handling the messages.
+     *
+     * @tparam T The type of the object handling the messages.
+     * @tparam M The type of the messages (possibly const-qualified).
+     */
+    template<typename T, typename M = Message>
+    class MessageDispatcher {
+
+    public:
+
+        /**
+         * The type of the functions handling the messages.
+         */
+        using Handler = void (*)(T &, M *);
+
+    private:
+
+        /**
+         * The name of the object handling the messages, used in the logs.
+         */
+        const char *owner;
+
+        /**
+         * The handlers of the messages, indexed by opcode.
+         */
+        std::array<Handler, (unsigned) MessageOpcode::NB_OPCODES> handlers;
+
+    public:
+
+        /**
+         * Creates a new MessageDispatcher with no handler.
+         *
+         * @param owner The name of the object handling the messages, used in the logs.
+         */
+        explicit MessageDispatcher(const char *owner) :
+                owner(owner),
+                handlers() {
+            // Nothing to do: everything is already initialized.
+        }
+
+        /**
+         * Associates a handler with an opcode.
+         *
+         * @param opcode The opcode to associate the handler with.
+         * @param handler The function handling the messages having the given opcode.
+         *
+         * @return This dispatcher.
+         */
+        MessageDispatcher &on(MessageOpcode opcode, Handler handler) {
+            handlers[(unsigned) opcode] = handler;
+            return *this;
+        }
+
+        /**
+         * Checks whether this dispatcher is able to handle the given message.
+         *
+         * @param message The message to check.
+         *
+         * @return Whether the message can be dispatched.
+         */
+        [[nodiscard]] bool handles(const Message *message) const {
+            return (message->version == PANO_PROTOCOL_VERSION)
+                   && (message->opcode < MessageOpcode::NB_OPCODES)
+                   && (handlers[(unsigned) message->opcode] != nullptr);
+        }
+
+        /**
+         * Dispatches a message to its handler, if any.
+         *
+         * @param handler The object handling the message.
+         * @param message The message to dispatch.
+         *
+         * @return Whether the message has been dispatched.
+         */
+        bool tryDispatch(T &handler, M *message) const {
+            if (!handles(message)) {
+                return false;
+            }
+            handlers[(unsigned) message->opcode](handler, message);
+            return true;
+        }
+
+        /**
+         * Dispatches a message to its handler.
+         * If the message cannot be handled, it is reported in the logs.
+         *
+         * @param handler The object handling the message.
+         * @param message The message to dispatch.
+         */
+        void dispatch(T &handler, M *message) const {
+            if (!tryDispatch(handler, message)) {
+                reportUndispatchedMessage(owner, message);
+            }
+        }
+
+    };
+
+}
+
+#endif
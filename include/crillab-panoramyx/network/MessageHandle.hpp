@@ -0,0 +1,125 @@
+/**
+ * PANORAMYX - Programming pArallel coNstraint sOlveRs mAde aMazingly easY.
+ * Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see {@link http://www.gnu.org/licenses}.
+ */
+
+/**
+ * @file MessageHandle.hpp
+ * @brief Owns a message allocated by the message pool.
+ *
+ * @author Thibault Falque
+ * @author Romain Wallon
+ *
+ * @copyright Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#ifndef PANORAMYX_MESSAGEHANDLE_HPP
+#define PANORAMYX_MESSAGEHANDLE_HPP
+
+#include "Message.hpp"
+
+namespace Panoramyx {
+
+    /**
+     * The MessageHandle is the unique owner of a message allocated by the
+     * MessagePool, and gives the message back to the pool when destroyed.
+     */
+    class MessageHandle {
+
+    private:
+
+        /**
+         * The owned message (may be null).
+         */
+        Message *message;
+
+    public:
+
+        /**
+         * Creates a new MessageHandle.
+         *
+         * @param message The message to take the ownership of.
+         */
+        explicit MessageHandle(Message *message = nullptr);
+
+        /**
+         * Creates a new MessageHandle by taking the ownership of the message of another handle.
+         *
+         * @param other The handle to take the message of.
+         */
+        MessageHandle(MessageHandle &&other) noexcept;
+
+        /**
+         * Takes the ownership of the message of another handle, releasing the message
+         * owned by this handle (if any).
+         *
+         * @param other The handle to take the message of.
+         *
+         * @return This handle.
+         */
+        MessageHandle &operator=(MessageHandle &&other) noexcept;
+
+        /**
+         * Disables the copy of MessageHandle, as messages have a unique owner.
+         */
+        MessageHandle(const MessageHandle &) = delete;
+
+        /**
+         * Disables the copy of MessageHandle, as messages have a unique owner.
+         */
+        MessageHandle &operator=(const MessageHandle &) = delete;
+
+        /**
+         * Destroys this MessageHandle, releasing the owned message (if any).
+         */
+        ~MessageHandle();
+
+        /**
+         * Gives the owned message.
+         *
+         * @return The owned message, or null if there is none.
+         */
+        [[nodiscard]] Message *get() const;
+
+        /**
+         * Gives access to the fields of the owned message.
+         *
+         * @return The owned message.
+         */
+        Message *operator->() const;
+
+        /**
+         * Gives up the ownership of the message, without releasing it.
+         *
+         * @return The message that was owned by this handle.
+         */
+        Message *release();
+
+        /**
+         * Releases the owned message (if any), and takes the ownership of another one.
+         *
+         * @param other The message to take the ownership of.
+         */
+        void reset(Message *other = nullptr);
+
+    };
+
+}
+
+#endif
@@ -0,0 +1,164 @@
+/**
+ * PANORAMYX - Programming pArallel coNstraint sOlveRs mAde aMazingly easY.
+ * Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see {@link http://www.gnu.org/licenses}.
+ */
+
+/**
+ * @file MessageMailbox.hpp
+ * @brief A mailbox in which messages are delivered to a communicator sharing the address space of their senders.
+ *
+ * @author Thibault Falque
+ * @author Romain Wallon
+ *
+ * @copyright Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#ifndef PANORAMYX_MESSAGEMAILBOX_HPP
+#define PANORAMYX_MESSAGEMAILBOX_HPP
+
+#include <atomic>
+#include <deque>
+#include <mutex>
+
+#include "Message.hpp"
+
+namespace Panoramyx {
+
+    /**
+     * The MessageMailbox stores the messages delivered to a communicator, and
+     * retrieves them following MPI's matching rules, including PANO_ANY_TAG and
+     * PANO_ANY_SOURCE.
+     * Delivering a message is lock-free: messages are pushed on an atomic stack,
+     * which is only drained (in delivery order) by the receiving threads.
+     * Messages from the same source are thus received in the order they were sent.
+     */
+    class MessageMailbox {
+
+    private:
+
+        /**
+         * The Node is an element of the stack of delivered messages.
+         */
+        struct Node {
+
+            /**
+             * The delivered message.
+             */
+            Message *message;
+
+            /**
+             * The node that was on top of the stack when this node was pushed.
+             */
+            Node *next;
+
+        };
+
+        /**
+         * The top of the stack of the messages delivered since the last drain.
+         */
+        std::atomic<Node *> head;
+
+        /**
+         * The number of messages delivered so far, which receivers wait on.
+         */
+        std::atomic<unsigned> sequence;
+
+        /**
+         * The mutex ensuring that only one receiving thread matches messages at a time.
+         */
+        std::mutex receiverMutex;
+
+        /**
+         * The drained messages that have not been received yet, in delivery order.
+         */
+        std::deque<Message *> pending;
+
+        /**
+         * Moves the messages delivered since the last drain to the pending messages.
+         * The receiver mutex must be held.
+         */
+        void drain();
+
+        /**
+         * Removes the first pending message matching the given tag and source.
+         * The receiver mutex must be held.
+         *
+         * @param tag The tag identifying the kind of the message to read.
+         * @param src The identifier of the source of the message.
+         *
+         * @return The matching message, or nullptr if there is none.
+         */
+        Message *match(int tag, int src);
+
+    public:
+
+        /**
+         * Creates a new MessageMailbox.
+         * The mailbox is initially empty.
+         */
+        MessageMailbox();
+
+        /**
+         * Destroys this MessageMailbox, releasing the messages that have not been received.
+         */
+        ~MessageMailbox();
+
+        /**
+         * Disables the copy of MessageMailbox.
+         */
+        MessageMailbox(const MessageMailbox &) = delete;
+
+        /**
+         * Disables the copy of MessageMailbox.
+         */
+        MessageMailbox &operator=(const MessageMailbox &) = delete;
+
+        /**
+         * Delivers a message to this mailbox, transferring its ownership.
+         * This method is lock-free and may be invoked by any thread.
+         *
+         * @param message The message to deliver.
+         */
+        void deliver(Message *message);
+
+        /**
+         * Receives a message, waiting until a matching message is delivered.
+         *
+         * @param tag The tag identifying the kind of the message to read (may be PANO_ANY_TAG).
+         * @param src The identifier of the source of the message (may be PANO_ANY_SOURCE).
+         *
+         * @return The received message.
+         */
+        Message *receive(int tag, int src);
+
+        /**
+         * Receives a message if a matching message has already been delivered.
+         *
+         * @param tag The tag identifying the kind of the message to read (may be PANO_ANY_TAG).
+         * @param src The identifier of the source of the message (may be PANO_ANY_SOURCE).
+         *
+         * @return The received message, or nullptr if there is none.
+         */
+        Message *tryReceive(int tag, int src);
+
+    };
+
+}
+
+#endif
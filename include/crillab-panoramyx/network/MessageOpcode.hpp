@@ -0,0 +1,133 @@
+/**
+ * PANORAMYX - Programming pArallel coNstraint sOlveRs mAde aMazingly easY.
+ * Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see {@link http://www.gnu.org/licenses}.
+ */
+
+/**
+ * @file MessageOpcode.hpp
+ * @brief Defines the operation codes identifying the messages exchanged by the solvers.
+ *
+ * @author Thibault Falque
+ * @author Romain Wallon
+ *
+ * @copyright Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#ifndef PANORAMYX_MESSAGEOPCODE_HPP
+#define PANORAMYX_MESSAGEOPCODE_HPP
+
+/**
+ * The version of the protocol, which is sent with every message.
+ * It must be increased whenever the opcodes or their parameters change.
+ */
+#define PANO_PROTOCOL_VERSION 10
+
+/**
+ * Applies the given macro to each opcode, together with its short name (used in the logs).
+ */
+#define PANO_MESSAGE_OPCODES(X) \
+    X(CONSTRAINT_SET_IGNORED, "igr") \
+    X(CONSTRAINTS_SET_IGNORED, "igs") \
+    X(CONSTRAINT_IS_IGNORED, "ig?") \
+    X(CONSTRAINT_SCORE, "scr") \
+    X(CONSTRAINTS_IS_IGNORED, "igq") \
+    X(CONSTRAINTS_SCORE, "scs") \
+    X(SUBSCRIBE_CONSTRAINTS_SCORE, "sbs") \
+    X(CONFIGURE, "cfg") \
+    X(INDEX, "idx") \
+    X(RESET, "rst") \
+    X(RESTORE, "rsr") \
+    X(GET_CAPABILITIES, "cp?") \
+    X(N_VARIABLES, "nv") \
+    X(GET_VARIABLES_MAPPING, "vmp") \
+    X(GET_AUXILIARY_VARIABLES, "aux") \
+    X(GET_CONSTRAINTS, "ctr") \
+    X(DECISION_VARIABLES, "dec") \
+    X(VALUE_HEURISTIC_STATIC, "vhs") \
+    X(N_CONSTRAINTS, "nc") \
+    X(IS_OPTIMIZATION, "op?") \
+    X(IS_MINIMIZATION, "min") \
+    X(GET_METADATA, "md?") \
+    X(SET_TIMEOUT, "t") \
+    X(SET_TIMEOUT_MS, "tm") \
+    X(SET_VERBOSITY, "v") \
+    X(ADD_SEARCH_LISTENER, "adl") \
+    X(SET_LOG_FILE, "log") \
+    X(SET_LOG_STREAM, "lgs") \
+    X(LOAD_INSTANCE, "lod") \
+    X(INSTANCE_DATA, "ins") \
+    X(LOAD_RECEIVED_INSTANCE, "ldr") \
+    X(SOLVE, "s") \
+    X(SOLVE_FILENAME, "sf") \
+    X(SOLVE_ASSUMPTIONS, "sa") \
+    X(INTERRUPT, "i") \
+    X(SOLUTION, "sol") \
+    X(MAP_SOLUTION, "map") \
+    X(CHECK_SOLUTION, "chk") \
+    X(CHECK_SOLUTION_ASSIGNMENT, "cka") \
+    X(END_SEARCH, "end") \
+    X(END_SEARCH_ACK, "eck") \
+    X(SATISFIABLE, "sat") \
+    X(UNSATISFIABLE, "ust") \
+    X(OPTIMUM_FOUND, "opt") \
+    X(UNSUPPORTED, "usp") \
+    X(UNKNOWN, "unk") \
+    X(LOWER_BOUND, "low") \
+    X(UPPER_BOUND, "upp") \
+    X(LOWER_UPPER_BOUND, "lub") \
+    X(GET_CURRENT_BOUND, "cur") \
+    X(GET_LOWER_BOUND, "lb?") \
+    X(GET_UPPER_BOUND, "ub?") \
+    X(NEW_BOUND_FOUND, "bnd")
+
+namespace Panoramyx {
+
+    /**
+     * The MessageOpcode enumerates the operations that may be requested by a message.
+     */
+    enum class MessageOpcode : unsigned char {
+
+        /**
+         * The opcode of a message whose operation has not been specified.
+         */
+        NONE,
+
+#define PANO_DECLARE_OPCODE(opcode, name) opcode,
+        PANO_MESSAGE_OPCODES(PANO_DECLARE_OPCODE)
+#undef PANO_DECLARE_OPCODE
+
+        /**
+         * The number of opcodes (this is not an actual opcode).
+         */
+        NB_OPCODES
+
+    };
+
+    /**
+     * Gives the short name of an opcode, to be displayed in the logs.
+     *
+     * @param opcode The opcode to get the name of.
+     *
+     * @return The name of the opcode.
+     */
+    const char *nameOf(MessageOpcode opcode);
+
+}
+
+#endif
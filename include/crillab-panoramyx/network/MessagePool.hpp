@@ -0,0 +1,111 @@
+/**
+ * PANORAMYX - Programming pArallel coNstraint sOlveRs mAde aMazingly easY.
+ * Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see {@link http://www.gnu.org/licenses}.
+ */
+
+/**
+ * @file MessagePool.hpp
+ * @brief Provides pooled memory for the messages sent through the network.
+ *
+ * @author Thibault Falque
+ * @author Romain Wallon
+ *
+ * @copyright Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#ifndef PANORAMYX_MESSAGEPOOL_HPP
+#define PANORAMYX_MESSAGEPOOL_HPP
+
+#include "Message.hpp"
+
+/**
+ * The binary logarithm of the size of the smallest pooled buffers.
+ */
+#define PANO_POOL_SMALLEST_SIZE_CLASS 6
+
+/**
+ * The binary logarithm of the size of the largest pooled buffers.
+ * Larger buffers are directly given back to the system when released.
+ */
+#define PANO_POOL_LARGEST_SIZE_CLASS 20
+
+/**
+ * The maximum number of free buffers kept by each thread for each size class.
+ */
+#define PANO_POOL_MAX_FREE_BUFFERS 32
+
+namespace Panoramyx {
+
+    /**
+     * The MessagePool allocates the memory used to store messages.
+     * Buffers are bucketed by size classes (powers of two), and released buffers
+     * are kept in thread-local free lists to be reused by later allocations, so
+     * that building, sending and receiving messages does not hit the system
+     * allocator on every message.
+     *
+     * Messages allocated by this pool must be released with release(), and never
+     * with free().
+     */
+    class MessagePool {
+
+    public:
+
+        /**
+         * Allocates the memory for a message.
+         * The fields of the returned message are not initialized.
+         *
+         * @param size The (full) size of the message, in bytes.
+         *
+         * @return The allocated message.
+         */
+        static Message *allocate(unsigned long size);
+
+        /**
+         * Ensures that a message allocated by this pool can store the given number of bytes.
+         * The content of the message is preserved, but the message may be moved.
+         *
+         * @param message The message to resize.
+         * @param size The (full) size the message must be able to store, in bytes.
+         *
+         * @return The resized message.
+         */
+        static Message *reallocate(Message *message, unsigned long size);
+
+        /**
+         * Releases a message allocated by this pool.
+         * Nothing happens if the message is null.
+         *
+         * @param message The message to release.
+         */
+        static void release(Message *message);
+
+        /**
+         * Gives the number of bytes that can be stored in a message allocated by this pool.
+         *
+         * @param message The message to get the capacity of.
+         *
+         * @return The capacity of the message, in bytes.
+         */
+        static unsigned long capacityOf(const Message *message);
+
+    };
+
+}
+
+#endif
@@ -0,0 +1,164 @@
+/**
+ * PANORAMYX - Programming pArallel coNstraint sOlveRs mAde aMazingly easY.
+ * Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see {@link http://www.gnu.org/licenses}.
+ */
+
+/**
+ * @file MessageReader.hpp
+ * @brief Reads the parameters of messages received through the network.
+ *
+ * @author Thibault Falque
+ * @author Romain Wallon
+ *
+ * @copyright Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#ifndef PANORAMYX_MESSAGEREADER_HPP
+#define PANORAMYX_MESSAGEREADER_HPP
+
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+#include <crillab-universe/core/UniverseType.hpp>
+
+#include "Message.hpp"
+
+namespace Panoramyx {
+
+    /**
+     * The MessageReader reads, in order, the parameters of a message that has been
+     * built with a MessageBuilder.
+     * Values are read in place: no copy of the message is made, so that the message
+     * must outlive the reader (and the string views it returns).
+     */
+    class MessageReader {
+
+    private:
+
+        /**
+         * The message to read the parameters of.
+         */
+        const Message *message;
+
+        /**
+         * The byte index of the next parameter to read in the message.
+         */
+        unsigned long offset;
+
+    public:
+
+        /**
+         * Creates a new MessageReader.
+         *
+         * @param message The message to read the parameters of.
+         * @param offset The byte index at which to start reading the parameters.
+         */
+        explicit MessageReader(const Message *message, unsigned long offset = 0);
+
+        /**
+         * Reads a fixed-size parameter, as written by MessageBuilder::withParameter().
+         *
+         * @tparam T The type of the parameter to read.
+         *
+         * @return The read parameter.
+         */
+        template<typename T>
+        T read() {
+            ensureRemaining(sizeof(T));
+            T value;
+            memcpy(&value, message->parameters + offset, sizeof(T));
+            offset += sizeof(T);
+            return value;
+        }
+
+        /**
+         * Reads an unsigned integer parameter, as written by MessageBuilder::withUnsigned().
+         *
+         * @return The read parameter.
+         */
+        unsigned long long readUnsigned();
+
+        /**
+         * Reads a signed integer parameter, as written by MessageBuilder::withInteger().
+         *
+         * @return The read parameter.
+         */
+        long long readInteger();
+
+        /**
+         * Reads a string parameter, as written by MessageBuilder::withString().
+         *
+         * @return A view on the read string, which is valid as long as the message is.
+         */
+        std::string_view readString();
+
+        /**
+         * Reads a big integer parameter, as written by MessageBuilder::withBigInteger().
+         *
+         * @return The read parameter.
+         */
+        Universe::BigInteger readBigInteger();
+
+        /**
+         * Reads an embedded message, as written by MessageBuilder::withMessage().
+         * The embedded message is copied so that it is properly aligned.
+         *
+         * @return The read message, which must be released with MessagePool::release()
+         *         (or owned by a MessageHandle).
+         */
+        Message *readMessage();
+
+        /**
+         * Reads a list of indices, as written by MessageBuilder::withIndices().
+         *
+         * @return The read indices.
+         */
+        std::vector<int> readIndices();
+
+        /**
+         * Checks whether there are remaining parameters to read.
+         *
+         * @return Whether the end of the message has not been reached yet.
+         */
+        [[nodiscard]] bool hasRemaining() const;
+
+        /**
+         * Gives the byte index of the next parameter to read in the message.
+         *
+         * @return The current offset of this reader.
+         */
+        [[nodiscard]] unsigned long getOffset() const;
+
+    private:
+
+        /**
+         * Ensures that the message still contains the given number of bytes.
+         *
+         * @param length The number of bytes that are about to be read.
+         *
+         * @throws Except::IllegalStateException If the message is too short.
+         */
+        void ensureRemaining(unsigned long length) const;
+
+    };
+
+}
+
+#endif
@@ -0,0 +1,173 @@
+/**
+ * PANORAMYX - Programming pArallel coNstraint sOlveRs mAde aMazingly easY.
+ * Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see {@link http://www.gnu.org/licenses}.
+ */
+
+/**
+ * @file NetworkCommunicationDecorator.hpp
+ * @brief Provides a base class for the communications adding a behavior to another communication.
+ *
+ * @author Thibault Falque
+ * @author Romain Wallon
+ *
+ * @copyright Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#ifndef PANORAMYX_NETWORKCOMMUNICATIONDECORATOR_HPP
+#define PANORAMYX_NETWORKCOMMUNICATIONDECORATOR_HPP
+
+#include "INetworkCommunication.hpp"
+
+namespace Panoramyx {
+
+    /**
+     * The NetworkCommunicationDecorator is the parent class of the communications
+     * that add a behavior (such as compression or instrumentation) on top of another
+     * communication.
+     * By default, all methods are delegated to the decorated communication, which is
+     * not owned by the decorator.
+     */
+    class NetworkCommunicationDecorator : public Panoramyx::INetworkCommunication {
+
+    protected:
+
+        /**
+         * The communication that is decorated.
+         */
+        Panoramyx::INetworkCommunication *decorated;
+
+        /**
+         * Creates a new NetworkCommunicationDecorator.
+         *
+         * @param decorated The communication to decorate.
+         */
+        explicit NetworkCommunicationDecorator(Panoramyx::INetworkCommunication *decorated);
+
+    public:
+
+        /**
+         * Gives the identifier of the current communicator.
+         *
+         * @return The identifier of the current communicator.
+         */
+        int getId() override;
+
+        /**
+         * Gives the number of processes that are currently communicating.
+         *
+         * @return The number of processes.
+         */
+        int nbProcesses() override;
+
+        /**
+         * Executes the given runnable as many times as needed by the decorated communication.
+         *
+         * @param runnable The runnable to execute.
+         */
+        void start(std::function<void()> runnable) override;
+
+        /**
+         * Binds a runnable to the current communicator of the decorated communication.
+         *
+         * @param runnable The runnable to bind.
+         *
+         * @return The bound runnable.
+         */
+        std::function<void()> attach(std::function<void()> runnable) override;
+
+        /**
+         * Receives a message.
+         *
+         * @param tag The tag identifying the kind of the message to read.
+         * @param src The identifier of the source of the message.
+         *
+         * @return The received message.
+         */
+        Message *receive(int tag, int src) override;
+
+        /**
+         * Sends a message.
+         *
+         * @param message The message to send.
+         * @param dest The identifier of the destination of the message.
+         */
+        void send(Message *message, int dest) override;
+
+        /**
+         * Sends a message, transferring its ownership to this communication.
+         *
+         * @param message The message to send.
+         * @param dest The identifier of the destination of the message.
+         */
+        void transfer(Message *message, int dest) override;
+
+        /**
+         * Starts receiving a message, without blocking.
+         *
+         * @param tag The tag identifying the kind of the message to read.
+         * @param src The identifier of the source of the message.
+         *
+         * @return The request to use to retrieve the message once received.
+         */
+        INetworkRequest *irecv(int tag, int src) override;
+
+        /**
+         * Starts sending a message, without blocking.
+         *
+         * @param message The message to send.
+         * @param dest The identifier of the destination of the message.
+         *
+         * @return The request to use to wait for the message to be sent.
+         */
+        INetworkRequest *isend(Message *message, int dest) override;
+
+        /**
+         * Sends the same message to several communicators.
+         *
+         * @param message The message to send.
+         * @param ranks The identifiers of the communicators that will receive the message.
+         */
+        void broadcast(Message *message, const std::vector<int> &ranks) override;
+
+        /**
+         * Waits until all the given requests have completed.
+         *
+         * @param requests The requests to wait for.
+         */
+        void waitAll(const std::vector<INetworkRequest *> &requests) override;
+
+        /**
+         * Checks whether any of the given requests has completed, without blocking.
+         *
+         * @param requests The requests to check.
+         *
+         * @return The index of a completed request, or -1 if none has completed.
+         */
+        int testAny(const std::vector<INetworkRequest *> &requests) override;
+
+        /**
+         * Finalizes the decorated communication.
+         */
+        void finalize() override;
+
+    };
+
+}
+
+#endif
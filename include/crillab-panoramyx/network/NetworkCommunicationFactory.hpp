@@ -32,6 +32,8 @@
 #ifndef PANORAMYX_NETWORKCOMMUNICATIONFACTORY_HPP
 #define PANORAMYX_NETWORKCOMMUNICATIONFACTORY_HPP
 
+#include <string>
+
 #include "INetworkCommunication.hpp"
 
 namespace Panoramyx {
@@ -66,9 +68,11 @@ namespace Panoramyx {
         /**
          * Creates an instance of MPINetworkCommunication.
          *
+         * @param chunkSize The maximum number of bytes sent in a single MPI transfer.
+         *
          * @return The created instance.
          */
-        INetworkCommunication *createMPINetworkCommunication();
+        INetworkCommunication *createMPINetworkCommunication(unsigned long chunkSize = PANO_DEFAULT_CHUNK_SIZE);
 
         /**
          * Creates an instance of ThreadCommunication.
@@ -79,6 +83,52 @@ namespace Panoramyx {
          */
         INetworkCommunication *createThreadCommunication(int nbThreads);
 
+        /**
+         * Creates an instance of HybridCommunication.
+         *
+         * @param nbThreads The number of threads to run in each MPI process.
+         * @param chunkSize The maximum number of bytes sent in a single MPI transfer.
+         *
+         * @return The created instance.
+         */
+        INetworkCommunication *createHybridCommunication(int nbThreads,
+                                                         unsigned long chunkSize = PANO_DEFAULT_CHUNK_SIZE);
+
+        /**
+         * Creates an instance of SharedMemoryCommunication.
+         * The communicating processes are forked by this method, which thus returns
+         * once in each of them.
+         *
+         * @param nbProcesses The number of processes to run.
+         * @param ringSize The capacity (in bytes) of the ring buffers between processes.
+         *
+         * @return The created instance.
+         */
+        INetworkCommunication *createSharedMemoryCommunication(int nbProcesses,
+                                                               unsigned long ringSize = PANO_DEFAULT_RING_SIZE);
+
+        /**
+         * Creates an instance of InstrumentedNetworkCommunication.
+         *
+         * @param communication The communication to decorate.
+         * @param reportFile The prefix of the path of the file in which to write the report.
+         *
+         * @return The created instance.
+         */
+        INetworkCommunication *createInstrumentedCommunication(INetworkCommunication *communication,
+                                                               const std::string &reportFile);
+
+        /**
+         * Creates an instance of CompressedNetworkCommunication.
+         *
+         * @param communication The communication to decorate.
+         * @param threshold The size (in bytes) of the parameters above which a message is compressed.
+         *
+         * @return The created instance.
+         */
+        INetworkCommunication *createCompressedCommunication(INetworkCommunication *communication,
+                                                             unsigned long threshold = PANO_DEFAULT_COMPRESSION_THRESHOLD);
+
     };
 
 }
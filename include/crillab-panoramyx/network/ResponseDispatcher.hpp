@@ -0,0 +1,135 @@
+/**
+ * PANORAMYX - Programming pArallel coNstraint sOlveRs mAde aMazingly easY.
+ * Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see {@link http://www.gnu.org/licenses}.
+ */
+
+/**
+ * @file ResponseDispatcher.hpp
+ * @brief Matches the responses sent by a remote communicator with the requests they answer.
+ *
+ * @author Thibault Falque
+ * @author Romain Wallon
+ *
+ * @copyright Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#ifndef PANORAMYX_RESPONSEDISPATCHER_HPP
+#define PANORAMYX_RESPONSEDISPATCHER_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+
+#include "INetworkCommunication.hpp"
+
+namespace Panoramyx {
+
+    /**
+     * The ResponseDispatcher demultiplexes the responses sent by a remote communicator,
+     * so that several requests may be pending at the same time.
+     * Each request is given an identifier, which the remote communicator copies in its
+     * response (see MessageBuilder::inResponseTo()).
+     *
+     * There is no dedicated receiving thread: the first thread waiting for a response
+     * receives the responses on behalf of the other waiting threads, until its own
+     * response arrives.
+     */
+    class ResponseDispatcher {
+
+    private:
+
+        /**
+         * The network communication used to receive the responses.
+         */
+        Panoramyx::INetworkCommunication *communicator;
+
+        /**
+         * The identifier of the communicator sending the responses.
+         */
+        int rank;
+
+        /**
+         * The identifier of the last request that has been created.
+         */
+        std::atomic<unsigned int> lastRequestId;
+
+        /**
+         * The responses that have been received, but not retrieved yet.
+         */
+        std::map<unsigned int, Panoramyx::Message *> responses;
+
+        /**
+         * Whether a thread is currently receiving responses.
+         */
+        bool receiving;
+
+        /**
+         * The mutex protecting the access to the received responses.
+         */
+        std::mutex responsesMutex;
+
+        /**
+         * The condition variable notified each time a response is received.
+         */
+        std::condition_variable received;
+
+    public:
+
+        /**
+         * Creates a new ResponseDispatcher.
+         *
+         * @param rank The identifier of the communicator sending the responses.
+         */
+        explicit ResponseDispatcher(int rank);
+
+        /**
+         * Destroys this ResponseDispatcher, releasing the responses that have not been retrieved.
+         */
+        ~ResponseDispatcher();
+
+        /**
+         * Sets the network communication used to receive the responses.
+         *
+         * @param communicator The communicator to set.
+         */
+        void setCommunicator(Panoramyx::INetworkCommunication *communicator);
+
+        /**
+         * Creates the identifier of a new request.
+         *
+         * @return The identifier of the request, which is never 0.
+         */
+        unsigned int newRequestId();
+
+        /**
+         * Waits for the response to a request.
+         *
+         * @param requestId The identifier of the request.
+         *
+         * @return The response to the request, which must be released with MessagePool::release()
+         *         (or owned by a MessageHandle).
+         */
+        Panoramyx::Message *await(unsigned int requestId);
+
+    };
+
+}
+
+#endif
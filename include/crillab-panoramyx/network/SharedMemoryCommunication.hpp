@@ -0,0 +1,281 @@
+/**
+ * PANORAMYX - Programming pArallel coNstraint sOlveRs mAde aMazingly easY.
+ * Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see {@link http://www.gnu.org/licenses}.
+ */
+
+/**
+ * @file SharedMemoryCommunication.hpp
+ * @brief An implementation of INetworkCommunication based on POSIX shared memory.
+ *
+ * @author Thibault Falque
+ * @author Romain Wallon
+ *
+ * @copyright Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#ifndef PANORAMYX_SHAREDMEMORYCOMMUNICATION_HPP
+#define PANORAMYX_SHAREDMEMORYCOMMUNICATION_HPP
+
+#include <mutex>
+#include <vector>
+
+#include <sys/types.h>
+
+#include "INetworkCommunication.hpp"
+#include "MessageMailbox.hpp"
+
+namespace Panoramyx {
+
+    /**
+     * The SharedMemoryCommunication is an implementation of INetworkCommunication
+     * for processes running on a single node.
+     * The processes are forked when the communication is created, and exchange
+     * messages through single-producer single-consumer ring buffers (one for each
+     * ordered pair of processes) stored in a POSIX shared memory segment.
+     * Processes waiting for a message (or for space in a ring) sleep on futexes
+     * stored in the segment, and are only woken up when needed.
+     */
+    class SharedMemoryCommunication : public Panoramyx::INetworkCommunication {
+
+    private:
+
+        /**
+         * The PartialMessage is a message that is being read from a ring.
+         */
+        struct PartialMessage {
+
+            /**
+             * The message being read, or nullptr while its header is being read.
+             */
+            Message *message;
+
+            /**
+             * The bytes of the header of the message being read.
+             */
+            alignas(Message) char header[sizeof(Message)];
+
+            /**
+             * The number of bytes of the message read so far.
+             */
+            unsigned long received;
+
+            /**
+             * The total number of bytes of the message.
+             */
+            unsigned long total;
+
+        };
+
+        /**
+         * The identifier of the current process.
+         */
+        int id;
+
+        /**
+         * The number of communicating processes.
+         */
+        int nbProcs;
+
+        /**
+         * The capacity (in bytes) of each ring.
+         */
+        unsigned long ringSize;
+
+        /**
+         * The shared memory segment in which the rings are stored.
+         */
+        char *segment;
+
+        /**
+         * The size (in bytes) of the shared memory segment.
+         */
+        unsigned long segmentSize;
+
+        /**
+         * The processes forked by the current process (only for process 0).
+         */
+        std::vector<pid_t> children;
+
+        /**
+         * The mutexes ensuring that the threads of the current process do not
+         * interleave the messages they send to the same process.
+         */
+        std::mutex *sendMutexes;
+
+        /**
+         * The mutex ensuring that only one thread reads the rings at a time.
+         */
+        std::mutex receiveMutex;
+
+        /**
+         * The messages that are being read from the ring of each process.
+         */
+        std::vector<PartialMessage> incoming;
+
+        /**
+         * The mailbox in which the messages read from the rings are delivered.
+         */
+        Panoramyx::MessageMailbox mailbox;
+
+        /**
+         * Creates a new SharedMemoryCommunication.
+         *
+         * @param id The identifier of the current process.
+         * @param nbProcs The number of communicating processes.
+         * @param ringSize The capacity (in bytes) of each ring.
+         * @param segment The shared memory segment in which the rings are stored.
+         * @param segmentSize The size (in bytes) of the shared memory segment.
+         */
+        SharedMemoryCommunication(int id, int nbProcs, unsigned long ringSize, char *segment,
+                                  unsigned long segmentSize);
+
+        /**
+         * Writes bytes to the ring going from the current process to the given process,
+         * waiting for space when the ring is full.
+         * While waiting, the incoming rings are drained, so that two processes sending
+         * large messages to each other do not wait for each other forever.
+         *
+         * @param bytes The bytes to write.
+         * @param length The number of bytes to write.
+         * @param dest The identifier of the process reading the ring.
+         */
+        void write(const char *bytes, unsigned long length, int dest);
+
+        /**
+         * Reads the bytes available in the rings of the current process, and delivers
+         * the messages they complete to the mailbox.
+         * The receive mutex must be held.
+         */
+        void drain();
+
+        /**
+         * Wakes up the threads of a process that may be waiting for a message.
+         *
+         * @param process The identifier of the process to wake up.
+         */
+        void notify(int process);
+
+        /**
+         * Receives a message if it is already available.
+         *
+         * @param tag The tag identifying the kind of the message to read.
+         * @param src The identifier of the source of the message.
+         *
+         * @return The received message, or nullptr if there is none.
+         */
+        Message *tryReceive(int tag, int src);
+
+        /**
+         * The SharedMemoryReceiveRequest polls the messages it is waiting for.
+         */
+        friend class SharedMemoryReceiveRequest;
+
+    public:
+
+        /**
+         * Creates the shared memory segment and forks the communicating processes.
+         * This method must be invoked before any thread is started (in particular,
+         * before the JVM is created), and returns once in each process.
+         *
+         * @param nbProcesses The number of communicating processes.
+         * @param ringSize The capacity (in bytes) of each ring.
+         *
+         * @return The SharedMemoryCommunication of the current process.
+         *
+         * @throws Except::IllegalStateException If the segment cannot be created.
+         */
+        static SharedMemoryCommunication *create(int nbProcesses, unsigned long ringSize);
+
+        /**
+         * Destroys this SharedMemoryCommunication.
+         */
+        ~SharedMemoryCommunication() override;
+
+        /**
+         * Gives the identifier of the current communicator.
+         *
+         * @return The identifier of the current communicator.
+         */
+        int getId() override;
+
+        /**
+         * Gives the number of processes that are currently communicating.
+         *
+         * @return The number of processes.
+         */
+        int nbProcesses() override;
+
+        /**
+         * Executes the given runnable as many times as needed by this strategy.
+         *
+         * @param runnable The runnable to execute.
+         */
+        void start(std::function<void()> runnable) override;
+
+        /**
+         * Receives a message.
+         *
+         * @param tag The tag identifying the kind of the message to read.
+         * @param src The identifier of the source of the message (i.e., the communicator that sent it).
+         *
+         * @return The received message.
+         */
+        Message *receive(int tag, int src) override;
+
+        /**
+         * Sends a message.
+         *
+         * @param message The message to send.
+         * @param dest The identifier of the destination of the message (i.e., the communicator that will receive it).
+         */
+        void send(Message *message, int dest) override;
+
+        /**
+         * Starts receiving a message, without blocking.
+         *
+         * @param tag The tag identifying the kind of the message to read.
+         * @param src The identifier of the source of the message (i.e., the communicator that sent it).
+         *
+         * @return The request to use to retrieve the message once received.
+         */
+        INetworkRequest *irecv(int tag, int src) override;
+
+        /**
+         * Sends a message.
+         * The message is copied to the ring of its destination, so the returned
+         * request has always completed.
+         *
+         * @param message The message to send, which is released once sent.
+         * @param dest The identifier of the destination of the message (i.e., the communicator that will receive it).
+         *
+         * @return The request to use to wait for the message to be sent.
+         */
+        INetworkRequest *isend(Message *message, int dest) override;
+
+        /**
+         * Finalizes the communication between the different communicators.
+         * Process 0 waits for all the other processes to terminate.
+         */
+        void finalize() override;
+
+    };
+
+}
+
+#endif
@@ -0,0 +1,117 @@
+/**
+ * PANORAMYX - Programming pArallel coNstraint sOlveRs mAde aMazingly easY.
+ * Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see {@link http://www.gnu.org/licenses}.
+ */
+
+/**
+ * @file SharedMemoryReceiveRequest.hpp
+ * @brief A pending non-blocking receive through shared memory.
+ *
+ * @author Thibault Falque
+ * @author Romain Wallon
+ *
+ * @copyright Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#ifndef PANORAMYX_SHAREDMEMORYRECEIVEREQUEST_HPP
+#define PANORAMYX_SHAREDMEMORYRECEIVEREQUEST_HPP
+
+#include "INetworkRequest.hpp"
+
+namespace Panoramyx {
+
+    /**
+     * Forward declaration of SharedMemoryCommunication.
+     */
+    class SharedMemoryCommunication;
+
+    /**
+     * The SharedMemoryReceiveRequest represents a message to be received by a
+     * SharedMemoryCommunication, which reads its rings each time the request is tested.
+     */
+    class SharedMemoryReceiveRequest : public Panoramyx::INetworkRequest {
+
+    private:
+
+        /**
+         * The communication used to receive the message.
+         */
+        Panoramyx::SharedMemoryCommunication *communication;
+
+        /**
+         * The tag identifying the kind of the message to read.
+         */
+        int tag;
+
+        /**
+         * The identifier of the source of the message.
+         */
+        int src;
+
+        /**
+         * Whether the message has been received.
+         */
+        bool completed;
+
+        /**
+         * The received message, until it is retrieved.
+         */
+        Message *message;
+
+    public:
+
+        /**
+         * Creates a new SharedMemoryReceiveRequest.
+         *
+         * @param communication The communication used to receive the message.
+         * @param tag The tag identifying the kind of the message to read.
+         * @param src The identifier of the source of the message.
+         */
+        SharedMemoryReceiveRequest(Panoramyx::SharedMemoryCommunication *communication, int tag, int src);
+
+        /**
+         * Destroys this SharedMemoryReceiveRequest.
+         * The received message is released if it has not been retrieved.
+         */
+        ~SharedMemoryReceiveRequest() override;
+
+        /**
+         * Checks whether the message has been received, without blocking.
+         *
+         * @return Whether the message has been received.
+         */
+        bool test() override;
+
+        /**
+         * Waits until the message has been received.
+         */
+        void wait() override;
+
+        /**
+         * Gives the received message.
+         *
+         * @return The received message, or nullptr.
+         */
+        Message *getMessage() override;
+
+    };
+
+}
+
+#endif
@@ -32,20 +32,19 @@
 #ifndef PANORAMYX_THREADCOMMUNICATION_HPP
 #define PANORAMYX_THREADCOMMUNICATION_HPP
 
-#include <map>
 #include <thread>
 #include <vector>
 #include <functional>
 
 #include "INetworkCommunication.hpp"
-#include "../utils/BlockingDeque.hpp"
+#include "MessageMailbox.hpp"
 
 namespace Panoramyx {
 
     /**
      * The ThreadCommunication is an implementation of INetworkCommunication
      * that relies on threads to run different operations in parallel and uses
-     * blocking queues to communicate between threads.
+     * one mailbox per thread to communicate between threads.
      */
     class ThreadCommunication : public INetworkCommunication {
 
@@ -62,19 +61,16 @@ namespace Panoramyx {
         std::vector<std::thread> threads;
 
         /**
-         * The map associating to each thread identifier their communicator identifier.
+         * The mailboxes in which the messages are delivered to each thread.
          */
-        std::map<std::thread::id, int> ids;
+        std::vector<Panoramyx::MessageMailbox *> mailboxes;
 
         /**
-         * The queue that are used to exchange information between threads.
+         * The identifier of the current thread as a communicator.
+         * Threads that have not been started by a ThreadCommunication are identified as 0,
+         * unless they execute a runnable bound with attach().
          */
-        std::vector<std::map<std::pair<int, int>, Panoramyx::BlockingDeque<Message *> *>> queues;
-
-        /**
-         * The mutex used to add new communication queues.
-         */
-        std::mutex newqmutex;
+        static thread_local int threadId;
 
     public:
 
@@ -88,7 +84,7 @@ namespace Panoramyx {
         /**
          * Destroys this ThreadCommunication.
          */
-        ~ThreadCommunication() override = default;
+        ~ThreadCommunication() override;
 
         /**
          * Gives the identifier of the current communicator.
@@ -111,16 +107,25 @@ namespace Panoramyx {
          */
         void start(std::function<void()> runnable) override;
 
+        /**
+         * Binds a runnable to the current communicator, so that a helper thread
+         * executing it uses the identifier of the current thread.
+         *
+         * @param runnable The runnable to bind.
+         *
+         * @return The bound runnable.
+         */
+        std::function<void()> attach(std::function<void()> runnable) override;
+
         /**
          * Receives a message.
          *
          * @param tag The tag identifying the kind of the message to read.
          * @param src The identifier of the source of the message (i.e., the communicator that sent it).
-         * @param size The maximum size of the message to read.
          *
          * @return The received message.
          */
-        Message *receive(int tag, int src, unsigned long size) override;
+        Message *receive(int tag, int src) override;
 
         /**
          * Sends a message.
@@ -130,6 +135,35 @@ namespace Panoramyx {
          */
         void send(Message *message, int dest) override;
 
+        /**
+         * Sends a message, transferring its ownership to the destination thread.
+         * The message is delivered without being copied.
+         *
+         * @param message The message to send.
+         * @param dest The identifier of the destination of the message (i.e., the communicator that will receive it).
+         */
+        void transfer(Message *message, int dest) override;
+
+        /**
+         * Starts receiving a message, without blocking.
+         *
+         * @param tag The tag identifying the kind of the message to read.
+         * @param src The identifier of the source of the message (i.e., the communicator that sent it).
+         *
+         * @return The request to use to retrieve the message once received.
+         */
+        INetworkRequest *irecv(int tag, int src) override;
+
+        /**
+         * Starts sending a message, without blocking.
+         *
+         * @param message The message to send, which is released once sent.
+         * @param dest The identifier of the destination of the message (i.e., the communicator that will receive it).
+         *
+         * @return The request to use to wait for the message to be sent.
+         */
+        INetworkRequest *isend(Message *message, int dest) override;
+
         /**
          * Finalizes the communication between the different communicators.
          */
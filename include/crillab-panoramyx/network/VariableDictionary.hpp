@@ -0,0 +1,129 @@
+/**
+ * PANORAMYX - Programming pArallel coNstraint sOlveRs mAde aMazingly easY.
+ * Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see {@link http://www.gnu.org/licenses}.
+ */
+
+/**
+ * @file VariableDictionary.hpp
+ * @brief Assigns dense indices to the variables of a solver, to identify them in the messages.
+ *
+ * @author Thibault Falque
+ * @author Romain Wallon
+ *
+ * @copyright Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#ifndef PANORAMYX_VARIABLEDICTIONARY_HPP
+#define PANORAMYX_VARIABLEDICTIONARY_HPP
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "MessageBuilder.hpp"
+#include "MessageReader.hpp"
+
+namespace Panoramyx {
+
+    /**
+     * The VariableDictionary assigns dense indices to the variables of a solver, so that
+     * messages identify the variables by their index rather than by their name.
+     * The dictionary is sent once by the remote solver after an instance has been loaded,
+     * so that both sides share the same indices.
+     *
+     * A variable that is not in the dictionary is still identified by its name, so that
+     * an empty dictionary may always be used.
+     */
+    class VariableDictionary {
+
+    private:
+
+        /**
+         * The names of the variables, in the order of their index.
+         */
+        std::vector<std::string> names;
+
+        /**
+         * The index of each variable.
+         */
+        std::unordered_map<std::string, unsigned long> indices;
+
+    public:
+
+        /**
+         * Creates a new, empty, VariableDictionary.
+         */
+        VariableDictionary() = default;
+
+        /**
+         * Creates a new VariableDictionary.
+         *
+         * @param names The names of the variables, in the order of their index.
+         */
+        explicit VariableDictionary(std::vector<std::string> names);
+
+        /**
+         * Gives the number of variables in this dictionary.
+         *
+         * @return The number of variables.
+         */
+        [[nodiscard]] unsigned long size() const;
+
+        /**
+         * Writes this dictionary to a message.
+         *
+         * @param builder The builder of the message.
+         */
+        void writeTo(Panoramyx::MessageBuilder &builder) const;
+
+        /**
+         * Reads a dictionary from a message.
+         *
+         * @param reader The reader of the message.
+         *
+         * @return The read dictionary.
+         */
+        static VariableDictionary readFrom(Panoramyx::MessageReader &reader);
+
+        /**
+         * Writes the identifier of a variable to a message.
+         * The index of the variable is written if it is in this dictionary, and its name
+         * otherwise.
+         *
+         * @param builder The builder of the message.
+         * @param name The name of the variable.
+         */
+        void writeVariable(Panoramyx::MessageBuilder &builder, const std::string &name) const;
+
+        /**
+         * Reads the identifier of a variable from a message.
+         *
+         * @param reader The reader of the message.
+         *
+         * @return The name of the read variable.
+         *
+         * @throws IllegalStateException If the read index is not in this dictionary.
+         */
+        [[nodiscard]] std::string readVariable(Panoramyx::MessageReader &reader) const;
+
+    };
+
+}
+
+#endif
@@ -32,37 +32,28 @@
 #ifndef PANORAMYX_REMOTECONSTRAINT_HPP
 #define PANORAMYX_REMOTECONSTRAINT_HPP
 
-#include <mutex>
 #include <vector>
 
 #include <crillab-universe/core/problem/IUniverseConstraint.hpp>
 
-#include "../network/INetworkCommunication.hpp"
+#include "../solver/PanoramyxSolver.hpp"
 
 namespace Panoramyx {
 
     /**
      * The RemoteConstraint provides the representation of a Universe constraint that is
      * defined in a remote solver.
+     * It is a lightweight view that only stores its index, and delegates all its
+     * operations to the solver that owns it.
      */
     class RemoteConstraint : public Universe::IUniverseConstraint {
 
     private:
 
         /**
-         * The communicator used to communicate with the remote solver.
+         * The solver that owns this constraint.
          */
-        Panoramyx::INetworkCommunication *communicator;
-
-        /**
-         * The mutex guaranteeing that two messages will not interfere.
-         */
-        std::mutex &mutex;
-
-        /**
-         * The rank of the solver that owns this constraint.
-         */
-        int solverRank;
+        Panoramyx::PanoramyxSolver *solver;
 
         /**
          * The index of this constraint in the solver.
@@ -74,11 +65,10 @@ namespace Panoramyx {
         /**
          * Creates a new RemoteConstraint.
          *
-         * @param communicator The communicator used to communicate with the remote solver.
-         * @param solverRank The rank of the solver that owns this constraint.
+         * @param solver The solver that owns this constraint.
          * @param constraintIndex The index of this constraint in the solver.
          */
-        RemoteConstraint(INetworkCommunication *communicator, std::mutex &mutex, int solverRank, int constraintIndex);
+        RemoteConstraint(Panoramyx::PanoramyxSolver *solver, int constraintIndex);
 
         /**
          * Destroys this RemoteConstraint.
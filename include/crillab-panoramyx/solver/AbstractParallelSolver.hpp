@@ -40,6 +40,7 @@
 
 #include "PanoramyxSolver.hpp"
 #include "../network/Message.hpp"
+#include "../network/MessageDispatcher.hpp"
 #include "../optim/decomposition/IBoundAllocationStrategy.hpp"
 #include "../utils/BlockingDeque.hpp"
 
@@ -138,6 +139,12 @@ namespace Panoramyx {
          */
         std::binary_semaphore end;
 
+        /**
+         * Whether the instance is read by this solver and broadcast to the solvers,
+         * instead of being read by each of them.
+         */
+        bool instanceBroadcast;
+
     public:
 
         /**
@@ -275,6 +282,15 @@ namespace Panoramyx {
          */
         void loadInstance(const std::string &filename) override;
 
+        /**
+         * Sets whether the instance is read by this solver and broadcast to the solvers.
+         * In this case, the solvers do not need to access the file of the instance (e.g.,
+         * through a network file system), as they load it from a local copy.
+         *
+         * @param instanceBroadcast Whether the instance is broadcast to the solvers.
+         */
+        void setInstanceBroadcast(bool instanceBroadcast);
+
         /**
          * Solves the problem associated to this solver.
          *
@@ -423,6 +439,13 @@ namespace Panoramyx {
         virtual void readBound(const Message *message);
         virtual void readUnknown(const Message *message);
         virtual void readEnd(const Message *message);
+
+        /**
+         * Reads a snapshot of the scores of the constraints periodically sent by a solver.
+         *
+         * @param message The message containing the scores.
+         */
+        void readConstraintScores(const Message *message);
         /**
          * Reads (in a dedicated thread) all the messages that are received.
          */
@@ -433,6 +456,30 @@ namespace Panoramyx {
              */
         virtual void endSearch();
 
+        /**
+         * Waits until the messages sent asynchronously to all the solvers have been delivered.
+         * Notifying all the solvers before waiting for any of them allows the messages to be
+         * sent in parallel.
+         */
+        void flushSolvers();
+
+        /**
+         * Prepares a solver for a new search on its current instance.
+         * Its root state is restored if it supports incremental solving, and it is reset otherwise.
+         *
+         * @param solver The solver to prepare.
+         */
+        void restart(Panoramyx::PanoramyxSolver *solver);
+
+        /**
+         * Sends the same message to all the solvers, using a broadcast of the communicator.
+         * The pending configuration commands and the messages already sent asynchronously
+         * to the solvers are delivered first, so that the broadcast message cannot overtake them.
+         *
+         * @param message The message to send, which is released by this method.
+         */
+        void broadcastToSolvers(Message *message);
+
     protected:
 
 
@@ -443,6 +490,14 @@ namespace Panoramyx {
          */
         virtual void readMessage(const Message *message);
 
+        /**
+         * Gives the table dispatching the messages received by the main solver
+         * to the appropriate methods.
+         *
+         * @return The dispatcher shared by all parallel solvers.
+         */
+        static const MessageDispatcher<AbstractParallelSolver, const Message> &dispatcher();
+
         /**
          * Prepares the solver at the given index to use it later on.
          *
@@ -63,6 +63,8 @@ namespace Panoramyx {
          */
         std::vector<std::string> jars;
 
+        bool instanceBroadcast = false;
+
     public:
 
         /**
@@ -116,6 +118,8 @@ namespace Panoramyx {
         Panoramyx::AbstractSolverBuilder *withNetworkCommunicator(
                 Panoramyx::INetworkCommunication *networkCommunication);
 
+        Panoramyx::AbstractSolverBuilder *withInstanceBroadcast(bool instanceBroadcast);
+
         /**
          * Builds the solver.
          *
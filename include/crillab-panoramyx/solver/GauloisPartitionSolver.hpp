@@ -43,6 +43,14 @@ namespace Panoramyx {
 
         Panoramyx::PartitionSolver *partitionSolver;
 
+        /**
+         * Gives the table dispatching the messages that are handled by the partition
+         * solver itself rather than by the underlying Gaulois solver.
+         *
+         * @return The dispatcher shared by all Gaulois partition solvers.
+         */
+        static const MessageDispatcher<GauloisPartitionSolver> &dispatcher();
+
     public:
         explicit GauloisPartitionSolver(Panoramyx::PartitionSolver *solver, INetworkCommunication *comm);
         void start() override;
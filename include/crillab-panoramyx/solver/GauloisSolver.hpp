@@ -32,11 +32,17 @@
 #ifndef PANORAMYX_GAULOISSOLVER_HPP
 #define PANORAMYX_GAULOISSOLVER_HPP
 
-#include <semaphore>
+#include <atomic>
+#include <condition_variable>
 #include <mutex>
+#include <thread>
 #include <crillab-universe/core/IUniverseSolver.hpp>
 #include <crillab-universe/optim/IOptimizationSolver.hpp>
 #include "../network/INetworkCommunication.hpp"
+#include "../network/MessageBuilder.hpp"
+#include "../network/MessageDispatcher.hpp"
+#include "../network/VariableDictionary.hpp"
+#include "../utils/SerialExecutor.hpp"
 
 namespace Panoramyx {
 
@@ -57,10 +63,8 @@ class GauloisSolver : public Universe::IUniverseSolver, public Universe::IOptimi
     INetworkCommunication *comm;
     bool interrupted = false;
     bool finishedB = false;
-    std::binary_semaphore finished = std::binary_semaphore(0);
-    std::mutex loadMutex;
+    std::recursive_mutex loadMutex;
     std::mutex boundMutex;
-    int nbSolved = 0;
     bool optimization;
     std::map<std::string,Universe::BigInteger> currentSolution;
     Universe::BigInteger currentBound;
@@ -72,7 +76,119 @@ class GauloisSolver : public Universe::IUniverseSolver, public Universe::IOptimi
 
     std::vector<Universe::BigInteger> sol;
 
+    /**
+     * The estimated size (in bytes) above which a solution is not attached anymore to the
+     * message notifying that it has been found, and must be queried by the main solver.
+     */
+    unsigned long solutionAttachmentLimit = PANO_DEFAULT_SOLUTION_ATTACHMENT_LIMIT;
+
+    /**
+     * Whether the attached solutions only contain the values that have changed since
+     * the previous attached solution.
+     */
+    bool solutionDelta = false;
+
+    /**
+     * The number of solutions that have been attached so far.
+     */
+    unsigned long long attachmentSequence = 0;
+
+    /**
+     * The last attached solution (as a vector of values), used as base of the deltas.
+     */
+    std::vector<Universe::BigInteger> attachedSolution;
+
+    /**
+     * The values of the last attached solution (as a mapping of the variables, in the
+     * order of the mapping), used as base of the deltas.
+     */
+    std::vector<Universe::BigInteger> attachedMapValues;
+
+    /**
+     * Attaches the current solution to the message notifying that it has been found,
+     * if it is small enough.
+     * In delta mode, only the values that have changed since the previous attached
+     * solution are written, given by their index.
+     *
+     * @param mb The builder of the message.
+     */
+    void attachSolution(MessageBuilder &mb);
+
+    /**
+     * Writes the current solution (as a vector of values) into a message.
+     *
+     * @param mb The builder of the message.
+     */
+    void writeSolution(MessageBuilder &mb);
+
+    /**
+     * Writes the current solution (as a mapping of the variables) into a message.
+     *
+     * @param mb The builder of the message.
+     */
+    void writeMapSolution(MessageBuilder &mb);
+
+    /**
+     * The dictionary of the variables sent to the main solver, used to identify the
+     * variables in the messages.
+     * It is empty until the main solver requests it, and after an instance is loaded.
+     */
+    VariableDictionary dictionary;
+
+    /**
+     * The mutex protecting the access to the dictionary of the variables.
+     */
+    std::mutex dictionaryMutex;
+
+    /**
+     * Sends the dictionary of the variables of the current instance to the main solver,
+     * which identifies the variables by their index from then on.
+     *
+     * @param m The message requesting the dictionary.
+     */
+    void sendVariableDictionary(Message *m);
+
+    /**
+     * Forgets the dictionary of the variables, as the instance is about to change.
+     */
+    void forgetVariableDictionary();
+
+    /**
+     * The path of the local copy of the instance that has been broadcast to this
+     * solver, if any.
+     */
+    std::string receivedInstance;
+
+    /**
+     * Writes the content of a broadcast instance into a local file, and acknowledges
+     * its reception to the sender.
+     *
+     * @param m The message containing the instance.
+     */
+    void receiveInstance(Message *m);
+
+    /**
+     * Loads the instance that has been broadcast to this solver, and removes its local copy.
+     */
+    void loadReceivedInstance();
+
     void readMessage(Message *m);
+
+    /**
+     * Gives the table dispatching the messages received by a Gaulois solver
+     * to the appropriate methods.
+     *
+     * @return The dispatcher shared by all Gaulois solvers.
+     */
+    static const MessageDispatcher<GauloisSolver> &dispatcher();
+
+    /**
+     * Applies, in order, all the configuration commands embedded in the given message.
+     * No search can start while the commands are applied.
+     *
+     * @param m The message containing the commands.
+     */
+    void configure(Message *m);
     int nVariables(Message *m);
     int nConstraints(Message *m);
     Universe::BigInteger getLowerBound(Message *m);
@@ -80,6 +196,14 @@ class GauloisSolver : public Universe::IUniverseSolver, public Universe::IOptimi
     Universe::BigInteger getCurrentBound(Message *m);
     bool isMinimization(Message *m);
 
+    /**
+     * Answers a snapshot of the properties of the solver that are needed before a search,
+     * so that they are all retrieved with a single query.
+     *
+     * @param m The message requesting the snapshot.
+     */
+    void getMetadata(Message *m);
+
     Universe::UniverseSolverResult solve(Message *m);
 
     Universe::UniverseSolverResult solve(std::string filename, Message *m);
@@ -91,8 +215,114 @@ class GauloisSolver : public Universe::IUniverseSolver, public Universe::IOptimi
 
     bool isConstraintIgnored(Message *m);
     void setConstraintIgnored(Message *m);
+
+    /**
+     * Sets, in a single pass, which constraints are ignored, as given by runs of
+     * constraints that are all ignored or all kept.
+     *
+     * @param m The message containing the runs of constraints.
+     */
+    void setConstraintsIgnored(Message *m);
+
+    /**
+     * Answers whether some constraints are ignored, as flags packed eight per byte.
+     *
+     * @param m The message giving the indices of the constraints.
+     */
+    void isConstraintsIgnored(Message *m);
+
+    /**
+     * Answers the scores of some constraints.
+     *
+     * @param m The message giving the indices of the constraints.
+     */
+    void getConstraintsScore(Message *m);
+
+    /**
+     * Writes the scores of some constraints into a message.
+     *
+     * @param mb The builder of the message.
+     * @param indices The indices of the constraints.
+     */
+    void writeConstraintsScore(MessageBuilder &mb, const std::vector<int> &indices);
+
+    /**
+     * The thread periodically sending the scores of the constraints, if any.
+     */
+    std::thread scoresThread;
+
+    /**
+     * Whether the scores of the constraints must be periodically sent.
+     */
+    bool scoresSubscribed = false;
+
+    /**
+     * The mutex protecting the subscription to the scores of the constraints.
+     */
+    std::mutex scoresMutex;
+
+    /**
+     * The condition used to wake up the thread sending the scores when the subscription ends.
+     */
+    std::condition_variable scoresCondition;
+
+    /**
+     * Starts (or stops) periodically sending the scores of some constraints to the
+     * solver requesting them.
+     *
+     * @param m The message giving the period and the indices of the constraints.
+     */
+    void subscribeConstraintsScore(Message *m);
+
+    /**
+     * Stops periodically sending the scores of the constraints, if they were sent.
+     */
+    void unsubscribeConstraintsScore();
+
     double getConstraintScore(Message *m);
 
+    /**
+     * The capabilities of the underlying solver, as declared when creating this solver.
+     */
+    unsigned capabilities = 0;
+
+    /**
+     * Whether the instance has been modified (e.g., by reducing domains or changing the
+     * bounds of the objective) since it has been loaded or reset, so that the solver
+     * cannot be simply restored, as what it has learnt may not hold anymore.
+     */
+    std::atomic<bool> instanceModified = false;
+
+    /**
+     * Restores the solver before a new search, by only resetting it if it is not
+     * incremental, or if its instance has been modified.
+     */
+    void restore();
+
+    /**
+     * Answers the capabilities of the underlying solver.
+     *
+     * @param m The message requesting the capabilities.
+     */
+    void getCapabilities(Message *m);
+
+    /**
+     * Runs a search on the thread of the executor, and sends its result to the main solver.
+     * If the search fails, its result is reported as unknown, so that the main solver does
+     * not wait for it forever.
+     *
+     * @param src The identifier of the main solver.
+     * @param search The search to run.
+     */
+    void searchAndReport(int src, const std::function<Universe::UniverseSolverResult()> &search);
+
+    /**
+     * The executor running the searches one after the other on the same thread, so
+     * that no thread is created (and attached to the JVM) for each search.
+     * It is declared last, so that it is destroyed (and its thread joined) first.
+     */
+    SerialExecutor executor;
+
    public:
     explicit GauloisSolver(Universe::IUniverseSolver *solver, INetworkCommunication *comm);
 
@@ -121,6 +351,34 @@ class GauloisSolver : public Universe::IUniverseSolver, public Universe::IOptimi
 
     void setLogFile(const std::string &filename) override;
 
+    /**
+     * Sets the estimated size (in bytes) above which a solution is not attached anymore
+     * to the message notifying that it has been found.
+     * A limit of 0 means that solutions are never attached.
+     *
+     * @param limit The limit to set.
+     */
+    void setSolutionAttachmentLimit(unsigned long limit);
+
+    /**
+     * Sets whether the attached solutions only contain the values that have changed since
+     * the previous attached solution.
+     * In this mode, the limit on the size of the attached solutions only applies to the
+     * deltas, as a full solution is needed as their base.
+     *
+     * @param solutionDelta Whether to attach deltas of solutions.
+     */
+    void setSolutionDelta(bool solutionDelta);
+
+    /**
+     * Sets the capabilities of the underlying solver, which cannot be discovered through
+     * its interface (e.g., PANO_CAPABILITY_INCREMENTAL if it keeps its root state and what
+     * it has learnt after a search under assumptions).
+     *
+     * @param capabilities The capabilities of the solver, as a combination of flags.
+     */
+    void setCapabilities(unsigned capabilities);
+
     virtual void start();
 
     ~GauloisSolver() override = default;
@@ -29,10 +29,16 @@
  * @license This project is released under the GNU LGPL3 License.
  */
 
+#include <future>
+#include <map>
+#include <string>
+#include <vector>
+
 #include <crillab-universe/core/IUniverseSolver.hpp>
 #include <crillab-universe/optim/IOptimizationSolver.hpp>
 
 #include "../network/INetworkCommunication.hpp"
+#include "../network/MessageReader.hpp"
 
 #ifndef PANORAMYX_PANORAMYXSOLVER_HPP
 #define PANORAMYX_PANORAMYXSOLVER_HPP
@@ -41,6 +47,13 @@ namespace Panoramyx {
 
     /**
      * The PanoramyxSolver defines an interface for the solvers that are used in a parallel solver.
+     *
+     * The methods whose name ends with "Async" send their query to the underlying solver
+     * without waiting for its answer, which is only waited for when the returned future
+     * is read.
+     * This allows to query several solvers at once, instead of paying one round trip per
+     * solver.
+     * The returned futures must always be read, as this is when the answer is retrieved.
      */
     class PanoramyxSolver : public Universe::IUniverseSolver, public Universe::IOptimizationSolver{
 
@@ -60,6 +73,13 @@ namespace Panoramyx {
          */
         virtual unsigned int getIndex() const = 0;
 
+        /**
+         * Gives the identifier of the communicator running the underlying solver.
+         *
+         * @return The rank of the solver.
+         */
+        virtual int getRank() const = 0;
+
         /**
          * Sets the network communication used to communicate with the underlying solver.
          *
@@ -72,6 +92,34 @@ namespace Panoramyx {
          */
         virtual void endSearch() = 0;
 
+        /**
+         * Loads the problem instance that has been broadcast to the underlying solver
+         * (see AbstractParallelSolver::setInstanceBroadcast()).
+         */
+        virtual void loadReceivedInstance() = 0;
+
+        /**
+         * Prepares this solver to acknowledge the reception of an instance that is about
+         * to be broadcast to the underlying solver.
+         *
+         * @return The identifier of the request that the underlying solver must answer
+         *         once it has received the instance.
+         */
+        virtual unsigned int expectInstance() = 0;
+
+        /**
+         * Waits for the underlying solver to acknowledge the reception of a broadcast instance.
+         *
+         * @param requestId The identifier given by expectInstance().
+         */
+        virtual void awaitInstance(unsigned int requestId) = 0;
+
+        /**
+         * Delivers the commands that are still pending for this solver, and waits until all
+         * the messages sent asynchronously to this solver have been delivered.
+         */
+        virtual void flush() = 0;
+
         /**
          * Gives the current result obtained by this solver so far.
          *
@@ -79,6 +127,173 @@ namespace Panoramyx {
          */
         virtual Universe::UniverseSolverResult getResult() = 0;
 
+        /**
+         * Gives the capabilities of the underlying solver (e.g., PANO_CAPABILITY_INCREMENTAL).
+         *
+         * @return The capabilities of the solver, as a combination of flags.
+         */
+        virtual unsigned getCapabilities() = 0;
+
+        /**
+         * Restores this solver in the state it had after loading its instance, before a
+         * new search.
+         * Contrary to reset(), an incremental solver keeps its root state and what it has
+         * learnt, provided that the previous searches have not modified its instance.
+         */
+        virtual void restore() = 0;
+
+        /**
+         * Sets, all at once, which constraints are ignored by this solver.
+         *
+         * @param ignored Whether each constraint is ignored, in the order of the constraints.
+         */
+        virtual void setIgnoredConstraints(const std::vector<bool> &ignored) = 0;
+
+        /**
+         * Sets whether a constraint is ignored by this solver.
+         *
+         * @param constraint The index of the constraint.
+         * @param ignored Whether the constraint is ignored.
+         */
+        virtual void setConstraintIgnored(int constraint, bool ignored) = 0;
+
+        /**
+         * Gives (asynchronously) whether some constraints are ignored by this solver.
+         *
+         * @param constraints The indices of the constraints.
+         *
+         * @return Whether each constraint is ignored, in the order of the given indices.
+         */
+        virtual std::future<std::vector<bool>> getIgnoredConstraintsAsync(const std::vector<int> &constraints) = 0;
+
+        /**
+         * Gives (asynchronously) the scores of some constraints in this solver.
+         *
+         * @param constraints The indices of the constraints.
+         *
+         * @return The score of each constraint, in the order of the given indices.
+         */
+        virtual std::future<std::vector<double>> getConstraintScoresAsync(const std::vector<int> &constraints) = 0;
+
+        /**
+         * Asks this solver to periodically send the scores of some constraints.
+         * The scores are received while a search is running, and are read with
+         * readConstraintScores().
+         *
+         * @param constraints The indices of the constraints.
+         * @param periodMs The number of milliseconds between two snapshots of the scores,
+         *        or 0 to stop sending them.
+         */
+        virtual void subscribeConstraintScores(const std::vector<int> &constraints, long periodMs) = 0;
+
+        /**
+         * Reads a snapshot of the scores of the constraints sent by the underlying solver
+         * since the main solver subscribed to them.
+         *
+         * @param reader The reader of the message, positioned on the scores.
+         */
+        virtual void readConstraintScores(Panoramyx::MessageReader &reader) = 0;
+
+        /**
+         * Gives the last snapshot of the scores of the constraints sent by this solver,
+         * in the order given when subscribing to them.
+         *
+         * @return The last snapshot of the scores (empty if none has been received).
+         */
+        virtual std::vector<double> getConstraintScoresSnapshot() = 0;
+
+        /**
+         * Reads the solution that the underlying solver has attached to the message notifying
+         * that it has found a solution (see PANO_FLAG_SOLUTION), so that it does not need
+         * to be queried afterwards.
+         *
+         * @param reader The reader of the message, positioned on the solution.
+         */
+        virtual void readAttachedSolution(Panoramyx::MessageReader &reader) = 0;
+
+        /**
+         * Records that the properties of the underlying solver (such as its bounds) may
+         * have changed without this solver being notified (e.g., during a search), so
+         * that they are not read from a cache anymore.
+         */
+        virtual void invalidateMetadata() = 0;
+
+        /**
+         * Checks (asynchronously) whether the associated problem is an optimization problem.
+         *
+         * @return Whether the problem is an optimization problem.
+         */
+        virtual std::future<bool> isOptimizationAsync() = 0;
+
+        /**
+         * Checks (asynchronously) whether the optimization problem is a minimization problem.
+         *
+         * @return Whether the underlying problem is a minimization problem.
+         */
+        virtual std::future<bool> isMinimizationAsync() = 0;
+
+        /**
+         * Gives (asynchronously) the number of variables defined in this solver.
+         *
+         * @return The number of variables.
+         */
+        virtual std::future<int> nVariablesAsync() = 0;
+
+        /**
+         * Gives (asynchronously) the current (best) lower bound of the underlying optimization problem.
+         *
+         * @return The current lower bound.
+         */
+        virtual std::future<Universe::BigInteger> getLowerBoundAsync() = 0;
+
+        /**
+         * Gives (asynchronously) the current (best) upper bound of the underlying optimization problem.
+         *
+         * @return The current upper bound.
+         */
+        virtual std::future<Universe::BigInteger> getUpperBoundAsync() = 0;
+
+        /**
+         * Gives (asynchronously) the current (best) bound that have been found by this solver.
+         *
+         * @return The current bound.
+         */
+        virtual std::future<Universe::BigInteger> getCurrentBoundAsync() = 0;
+
+        /**
+         * Gives (asynchronously) the solution found by this solver (if any).
+         *
+         * @return The solution found by this solver.
+         */
+        virtual std::future<std::vector<Universe::BigInteger>> solutionAsync() = 0;
+
+        /**
+         * Gives (asynchronously) the mapping between the names of the variables and the
+         * assignment found by this solver (if any).
+         *
+         * @param excludeAux Whether auxiliary variables should be excluded from the solution.
+         *
+         * @return The solution found by this solver.
+         */
+        virtual std::future<std::map<std::string, Universe::BigInteger>> mapSolutionAsync(bool excludeAux) = 0;
+
+        /**
+         * Checks (asynchronously) the last solution that has been computed by the solver.
+         *
+         * @return Whether the last solution is correct.
+         */
+        virtual std::future<bool> checkSolutionAsync() = 0;
+
+        /**
+         * Checks (asynchronously) whether the given assignment is a solution of the problem.
+         *
+         * @param assignment The assignment to check as a solution.
+         *
+         * @return Whether the given assignment is a solution of the problem.
+         */
+        virtual std::future<bool> checkSolutionAsync(
+                const std::map<std::string, Universe::BigInteger> &assignment) = 0;
+
     };
 
 }
@@ -32,6 +32,9 @@
 #ifndef PANORAMYX_REMOTESOLVER_HPP
 #define PANORAMYX_REMOTESOLVER_HPP
 
+#include <atomic>
+#include <deque>
+#include <future>
 #include <map>
 #include <mutex>
 #include <optional>
@@ -41,6 +44,11 @@
 #include <loguru/loguru.hpp>
 
 #include "PanoramyxSolver.hpp"
+#include "../problem/RemoteConstraint.hpp"
+#include "../network/MessageBuilder.hpp"
+#include "../network/MessageHandle.hpp"
+#include "../network/ResponseDispatcher.hpp"
+#include "../network/VariableDictionary.hpp"
 
 namespace Panoramyx {
 
@@ -53,50 +61,381 @@ namespace Panoramyx {
     private:
 
         /**
-         * The network communication used to communicate with the (real) remote solver.
+         * The Metadata is a snapshot of the properties of the remote solver that the main
+         * solver needs before a search, which are all retrieved with a single query.
          */
-        Panoramyx::INetworkCommunication *communicator;
+        struct Metadata {
+
+            /**
+             * The number of variables in the solver.
+             */
+            int nbVariables;
+
+            /**
+             * The number of constraints in the solver.
+             */
+            int nbConstraints;
+
+            /**
+             * Whether the problem to solve is an optimization problem.
+             */
+            bool optimization;
+
+            /**
+             * Whether the problem to solve is a minimization problem (if it is an
+             * optimization problem).
+             */
+            bool minimization;
+
+            /**
+             * The current lower bound of the problem (if it is an optimization problem).
+             */
+            Universe::BigInteger lowerBound;
+
+            /**
+             * The current upper bound of the problem (if it is an optimization problem).
+             */
+            Universe::BigInteger upperBound;
+
+            /**
+             * The auxiliary variables declared in the solver.
+             */
+            std::vector<std::string> auxiliaryVariables;
+
+        };
 
         /**
-         * The mutex guaranteeing that two messages will not interfere.
+         * The network communication used to communicate with the (real) remote solver.
          */
-        std::mutex mutex;
+        Panoramyx::INetworkCommunication *communicator;
 
         /**
          * The rank of this solver among all remote solvers (as assigned by the network communication strategy).
          */
         int rank;
 
+        /**
+         * The dispatcher matching the responses of the remote solver with the queries
+         * they answer, so that several queries may be pending at the same time.
+         */
+        Panoramyx::ResponseDispatcher responses;
+
         /**
          * The index of this solver among all remote solvers (as assigned by the main solver).
          */
         unsigned index;
 
         /**
-         * The number of variables in the solver (the value is cached).
+         * The views of the constraints stored in the remote solver, which are only
+         * created when the constraints are requested.
+         * A deque is used so that the views do not move when more views are created.
          */
-        int nbVariables = -1;
+        std::deque<Panoramyx::RemoteConstraint> constraintViews;
 
         /**
-         * The auxiliary variables declared in the solver (the vector is cached).
+         * The vector of the constraints stored in the remote solver, pointing to their views.
          */
-        std::vector<std::string> auxiliaryVariables;
+        std::vector<Universe::IUniverseConstraint *> remoteConstraints;
 
         /**
-         * The number of constraints in the solver (the value is cached).
+         * The number of times the metadata of the remote solver may have changed, i.e.,
+         * the number of times its instance, its bounds or its search have been changed.
          */
-        int nbConstraints = -1;
+        std::atomic<unsigned long> epoch;
 
         /**
-         * The vector of the constraints stored in the remote solver.
+         * The last snapshot of the metadata received from the remote solver.
+         * It is an optional because it is lazily cached.
          */
-        std::vector<Universe::IUniverseConstraint *> remoteConstraints;
+        std::optional<Metadata> metadata;
 
         /**
-         * Whether the problem to solve is an optimization problem.
-         * It is an optional because it is lazily cached.
+         * The epoch at which the cached snapshot has been requested.
+         */
+        unsigned long metadataEpoch;
+
+        /**
+         * The snapshot of the metadata that has been requested but not read yet.
+         * It is shared by all the queries made during the same epoch.
+         */
+        std::shared_future<Metadata> pendingMetadata;
+
+        /**
+         * The epoch at which the pending snapshot has been requested.
+         */
+        unsigned long pendingEpoch;
+
+        /**
+         * The mutex protecting the access to the snapshots of the metadata.
+         */
+        std::mutex metadataMutex;
+
+        /**
+         * The vectors of auxiliary variables that have been returned by getAuxiliaryVariables().
+         * They are never modified once returned, and a deque is used so that they do not move,
+         * which keeps the returned references valid when the metadata change.
+         */
+        std::deque<std::vector<std::string>> auxiliaryVariables;
+
+        /**
+         * The dictionary of the variables of the remote solver, requested each time an
+         * instance is loaded.
+         * While it is not valid, the variables are identified by their name.
+         */
+        std::shared_future<Panoramyx::VariableDictionary> dictionary;
+
+        /**
+         * The mutex protecting the access to the dictionary of the variables.
+         */
+        std::mutex dictionaryMutex;
+
+        /**
+         * The capabilities of the remote solver, requested at most once per instance.
+         */
+        std::shared_future<unsigned> capabilities;
+
+        /**
+         * The mutex protecting the access to the capabilities.
+         */
+        std::mutex capabilitiesMutex;
+
+        /**
+         * Forgets the capabilities of the remote solver, as its instance changes.
+         */
+        void forgetCapabilities();
+
+        /**
+         * The last solution (as a vector of values) attached by the remote solver to the
+         * message notifying that it has found it, if any.
+         */
+        std::optional<std::vector<Universe::BigInteger>> attachedSolution;
+
+        /**
+         * The last solution (as a mapping of the variables) attached by the remote solver
+         * to the message notifying that it has found it, if any.
+         */
+        std::optional<std::map<std::string, Universe::BigInteger>> attachedMapSolution;
+
+        /**
+         * The last solution (as a vector of values) received from the remote solver,
+         * to which the deltas of solutions are applied.
+         */
+        std::vector<Universe::BigInteger> baseSolution;
+
+        /**
+         * The last solution (as a mapping of the variables) received from the remote solver,
+         * to which the deltas of solutions are applied.
+         */
+        std::map<std::string, Universe::BigInteger> baseMapSolution;
+
+        /**
+         * The sequence number of the last solution received from the remote solver
+         * (0 if none).
+         */
+        unsigned long long baseSequence;
+
+        /**
+         * The mutex protecting the access to the attached solution.
+         */
+        std::mutex attachedSolutionMutex;
+
+        /**
+         * The last snapshot of the scores of the constraints sent by the remote solver.
+         */
+        std::vector<double> scoresSnapshot;
+
+        /**
+         * The mutex protecting the access to the snapshot of the scores.
+         */
+        std::mutex scoresMutex;
+
+        /**
+         * The requests of the messages sent asynchronously to the remote solver, that
+         * may not have been delivered yet.
+         */
+        std::vector<Panoramyx::INetworkRequest *> pendingRequests;
+
+        /**
+         * The mutex protecting the access to the pending requests.
+         */
+        std::mutex pendingMutex;
+
+        /**
+         * The configuration commands that have not been sent to the remote solver yet.
+         */
+        std::vector<Panoramyx::Message *> pendingConfiguration;
+
+        /**
+         * The mutex protecting the access to the pending configuration commands.
+         */
+        std::mutex configurationMutex;
+
+        /**
+         * Records a configuration command, to be sent together with the other pending
+         * commands before the next message that is not a configuration command.
+         *
+         * @param message The configuration command.
+         */
+        void configure(Panoramyx::Message *message);
+
+        /**
+         * Sends all the pending configuration commands in a single message.
+         */
+        void sendConfiguration();
+
+        /**
+         * Sends a message to the remote solver, after the pending configuration commands.
+         *
+         * @param message The message to send, which is released once sent.
+         */
+        void send(Panoramyx::Message *message);
+
+        /**
+         * Sends a message to the remote solver without waiting for it to be delivered.
+         * The message is released once delivered.
+         *
+         * @param message The message to send.
+         */
+        void post(Panoramyx::Message *message);
+
+        /**
+         * Waits until the messages posted to the remote solver have been delivered.
+         */
+        void waitPosted();
+
+        /**
+         * Sends a query to the remote solver, after the pending configuration commands.
+         *
+         * @param builder The builder of the query, which is completed and built by this method.
+         *
+         * @return The identifier of the query, used to retrieve its response.
+         */
+        unsigned int request(Panoramyx::MessageBuilder &builder);
+
+        /**
+         * Sends a query to the remote solver, and gives a future of its decoded response.
+         * The response is waited for when the future is read.
+         *
+         * @tparam T The type of the decoded response.
+         * @tparam D The type of the function decoding the response.
+         *
+         * @param builder The builder of the query, which is completed and built by this method.
+         * @param decode The function decoding the response.
+         *
+         * @return The future response to the query.
+         */
+        template<typename T, typename D>
+        std::future<T> query(Panoramyx::MessageBuilder &builder, D decode) {
+            unsigned int requestId = request(builder);
+            return std::async(std::launch::deferred, [this, requestId, decode]() {
+                Panoramyx::MessageHandle response(responses.await(requestId));
+                return decode(response.get());
+            });
+        }
+
+        /**
+         * Gives a future of a value that is already known.
+         *
+         * @tparam T The type of the value.
+         *
+         * @param value The value.
+         *
+         * @return The future value.
+         */
+        template<typename T>
+        static std::future<T> ready(T value) {
+            std::promise<T> promise;
+            promise.set_value(std::move(value));
+            return promise.get_future();
+        }
+
+        /**
+         * Forgets the solution attached by the remote solver, as it is not its current
+         * solution anymore.
+         */
+        void forgetAttachedSolution();
+
+        /**
+         * Rejects a delta of solution that does not match the last solution received
+         * from the remote solver, which will thus be queried afterwards.
+         * The base solution is dropped, so that no later delta is applied to it.
+         * This method must be called while holding the lock on the attached solution.
+         */
+        void invalidAttachedSolution();
+
+        /**
+         * Reads a solution (as a vector of values) from a message.
+         *
+         * @param reader The reader of the message.
+         *
+         * @return The read solution.
+         */
+        static std::vector<Universe::BigInteger> readSolution(Panoramyx::MessageReader &reader);
+
+        /**
+         * Reads the scores of some constraints from a message.
+         *
+         * @param reader The reader of the message.
+         *
+         * @return The read scores.
+         */
+        static std::vector<double> readScores(Panoramyx::MessageReader &reader);
+
+        /**
+         * Reads a solution (as a mapping of the variables) from a message.
+         *
+         * @param reader The reader of the message.
+         * @param variables The dictionary identifying the variables in the message.
+         *
+         * @return The read solution.
          */
-        std::optional<bool> optimization;
+        static std::map<std::string, Universe::BigInteger> readMapSolution(
+                Panoramyx::MessageReader &reader, const Panoramyx::VariableDictionary &variables);
+
+        /**
+         * Requests the dictionary of the variables of the instance that has just been
+         * loaded by the remote solver.
+         */
+        void requestVariableDictionary();
+
+        /**
+         * Forgets the dictionary of the variables of the remote solver, so that the
+         * variables are identified by their name.
+         */
+        void forgetVariableDictionary();
+
+        /**
+         * Gives the dictionary of the variables of the remote solver.
+         *
+         * @return The future dictionary, which is empty if it has not been requested.
+         */
+        std::shared_future<Panoramyx::VariableDictionary> variableDictionary();
+
+        /**
+         * Gives the snapshot of the metadata of the remote solver for the current epoch.
+         * The snapshot is only requested if it is neither cached nor already requested.
+         *
+         * @return The future snapshot.
+         */
+        std::shared_future<Metadata> metadataAsync();
+
+        /**
+         * Gives a future of a property read from the snapshot of the metadata of the
+         * remote solver.
+         *
+         * @tparam T The type of the property.
+         * @tparam E The type of the function extracting the property from the snapshot.
+         *
+         * @param extract The function extracting the property from the snapshot.
+         *
+         * @return The future property.
+         */
+        template<typename T, typename E>
+        std::future<T> fromMetadata(E extract) {
+            return std::async(std::launch::deferred, [snapshot = metadataAsync(), extract]() {
+                return extract(snapshot.get());
+            });
+        }
 
     public:
 
@@ -111,7 +450,7 @@ namespace Panoramyx {
         /**
          * Destroys this RemoteSolver.
          */
-        ~RemoteSolver() override = default;
+        ~RemoteSolver() override;
 
         /**
          * Sets the index of this solver, as assigned by the main solver.
@@ -127,6 +466,13 @@ namespace Panoramyx {
          */
         unsigned int getIndex() const override;
 
+        /**
+         * Gives the identifier of the communicator running the (real) remote solver.
+         *
+         * @return The rank of the solver.
+         */
+        int getRank() const override;
+
         /**
          * Sets the network communication used to communicate with the (real) remote solver.
          *
@@ -139,6 +485,21 @@ namespace Panoramyx {
          */
         void reset() override;
 
+        /**
+         * Gives the capabilities of the remote solver.
+         * They are only requested once per instance.
+         *
+         * @return The capabilities of the solver, as a combination of flags.
+         */
+        unsigned getCapabilities() override;
+
+        /**
+         * Restores this solver in the state it had after loading its instance, before a
+         * new search.
+         * The remote solver decides whether it actually needs to be reset.
+         */
+        void restore() override;
+
         /**
          * Gives the number of variables defined in this solver.
          *
@@ -248,6 +609,29 @@ namespace Panoramyx {
          */
         void loadInstance(const std::string &filename) override;
 
+        /**
+         * Loads the problem instance that has been broadcast to the remote solver.
+         */
+        void loadReceivedInstance() override;
+
+        /**
+         * Prepares this solver to acknowledge the reception of an instance that is about
+         * to be broadcast to the remote solver.
+         *
+         * @return The identifier of the request that the remote solver must answer
+         *         once it has received the instance.
+         */
+        unsigned int expectInstance() override;
+
+        /**
+         * Waits for the remote solver to acknowledge the reception of a broadcast instance.
+         * The acknowledgment is received through the dispatcher of the responses, so that
+         * it cannot be mistaken for the response to another query.
+         *
+         * @param requestId The identifier given by expectInstance().
+         */
+        void awaitInstance(unsigned int requestId) override;
+
         /**
          * Solves the problem associated to this solver.
          *
@@ -285,6 +669,12 @@ namespace Panoramyx {
          */
         void endSearch() override;
 
+        /**
+         * Sends the pending configuration commands to the remote solver, and waits until
+         * all the messages sent asynchronously to it have been delivered.
+         */
+        void flush() override;
+
         /**
          * Gives the current result obtained by this solver so far.
          *
@@ -292,6 +682,84 @@ namespace Panoramyx {
          */
         Universe::UniverseSolverResult getResult() override;
 
+        /**
+         * Sets, all at once, which constraints are ignored by this solver.
+         * The constraints are sent as runs of constraints that are all ignored or all
+         * kept, so that a single message is sent.
+         *
+         * @param ignored Whether each constraint is ignored, in the order of the constraints.
+         */
+        void setIgnoredConstraints(const std::vector<bool> &ignored) override;
+
+        /**
+         * Sets whether a constraint is ignored by this solver.
+         *
+         * @param constraint The index of the constraint.
+         * @param ignored Whether the constraint is ignored.
+         */
+        void setConstraintIgnored(int constraint, bool ignored) override;
+
+        /**
+         * Gives (asynchronously) whether some constraints are ignored by this solver.
+         * All the constraints are queried at once.
+         *
+         * @param constraints The indices of the constraints.
+         *
+         * @return Whether each constraint is ignored, in the order of the given indices.
+         */
+        std::future<std::vector<bool>> getIgnoredConstraintsAsync(const std::vector<int> &constraints) override;
+
+        /**
+         * Gives (asynchronously) the scores of some constraints in this solver.
+         * All the constraints are queried at once.
+         *
+         * @param constraints The indices of the constraints.
+         *
+         * @return The score of each constraint, in the order of the given indices.
+         */
+        std::future<std::vector<double>> getConstraintScoresAsync(const std::vector<int> &constraints) override;
+
+        /**
+         * Asks this solver to periodically send the scores of some constraints.
+         *
+         * @param constraints The indices of the constraints.
+         * @param periodMs The number of milliseconds between two snapshots of the scores,
+         *        or 0 to stop sending them.
+         */
+        void subscribeConstraintScores(const std::vector<int> &constraints, long periodMs) override;
+
+        /**
+         * Reads a snapshot of the scores of the constraints sent by the remote solver.
+         *
+         * @param reader The reader of the message, positioned on the scores.
+         */
+        void readConstraintScores(Panoramyx::MessageReader &reader) override;
+
+        /**
+         * Gives the last snapshot of the scores of the constraints sent by this solver.
+         *
+         * @return The last snapshot of the scores (empty if none has been received).
+         */
+        std::vector<double> getConstraintScoresSnapshot() override;
+
+        /**
+         * Reads the solution that the remote solver has attached to the message notifying
+         * that it has found a solution, so that it does not need to be queried afterwards.
+         * If only the values that have changed have been attached, they are applied to
+         * the last solution received from the remote solver.
+         *
+         * If the delta cannot be applied, the solution will be queried instead.
+         *
+         * @param reader The reader of the message, positioned on the solution.
+         */
+        void readAttachedSolution(Panoramyx::MessageReader &reader) override;
+
+        /**
+         * Records that the metadata of the remote solver may have changed, so that
+         * the cached snapshot is not used anymore.
+         */
+        void invalidateMetadata() override;
+
         /**
          * Gives the solution found by this solver (if any).
          *
@@ -396,6 +864,81 @@ namespace Panoramyx {
          */
         Universe::BigInteger getCurrentBound() override;
 
+        /**
+         * Checks (asynchronously) whether the associated problem is an optimization problem.
+         *
+         * @return Whether the problem is an optimization problem.
+         */
+        std::future<bool> isOptimizationAsync() override;
+
+        /**
+         * Checks (asynchronously) whether the optimization problem is a minimization problem.
+         *
+         * @return Whether the underlying problem is a minimization problem.
+         */
+        std::future<bool> isMinimizationAsync() override;
+
+        /**
+         * Gives (asynchronously) the number of variables defined in this solver.
+         *
+         * @return The number of variables.
+         */
+        std::future<int> nVariablesAsync() override;
+
+        /**
+         * Gives (asynchronously) the current (best) lower bound of the underlying optimization problem.
+         *
+         * @return The current lower bound.
+         */
+        std::future<Universe::BigInteger> getLowerBoundAsync() override;
+
+        /**
+         * Gives (asynchronously) the current (best) upper bound of the underlying optimization problem.
+         *
+         * @return The current upper bound.
+         */
+        std::future<Universe::BigInteger> getUpperBoundAsync() override;
+
+        /**
+         * Gives (asynchronously) the current (best) bound that have been found by this solver.
+         *
+         * @return The current bound.
+         */
+        std::future<Universe::BigInteger> getCurrentBoundAsync() override;
+
+        /**
+         * Gives (asynchronously) the solution found by this solver (if any).
+         *
+         * @return The solution found by this solver.
+         */
+        std::future<std::vector<Universe::BigInteger>> solutionAsync() override;
+
+        /**
+         * Gives (asynchronously) the mapping between the names of the variables and the
+         * assignment found by this solver (if any).
+         *
+         * @param excludeAux Whether auxiliary variables should be excluded from the solution.
+         *
+         * @return The solution found by this solver.
+         */
+        std::future<std::map<std::string, Universe::BigInteger>> mapSolutionAsync(bool excludeAux) override;
+
+        /**
+         * Checks (asynchronously) the last solution that has been computed by the solver.
+         *
+         * @return Whether the last solution is correct.
+         */
+        std::future<bool> checkSolutionAsync() override;
+
+        /**
+         * Checks (asynchronously) whether the given assignment is a solution of the problem.
+         *
+         * @param assignment The assignment to check as a solution.
+         *
+         * @return Whether the given assignment is a solution of the problem.
+         */
+        std::future<bool> checkSolutionAsync(const std::map<std::string, Universe::BigInteger> &assignment) override;
+
     };
 
 }
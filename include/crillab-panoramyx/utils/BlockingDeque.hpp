@@ -115,6 +115,31 @@ namespace Panoramyx {
             return e;
         }
 
+        /**
+         * Gives the next element from this queue, if there is one.
+         * This method never blocks.
+         *
+         * @param e The reference in which to store the element at the front of this queue.
+         *
+         * @return Whether an element has been retrieved.
+         */
+        bool tryGet(E &e) {
+            if (!semaphore.try_acquire()) {
+                return false;
+            }
+
+            mutex.lock();
+            if (deque.empty()) {
+                mutex.unlock();
+                return false;
+            }
+
+            e = deque.front();
+            deque.pop_front();
+            mutex.unlock();
+            return true;
+        }
+
         /**
          * Removes all the elements from this queue.
          */
@@ -0,0 +1,133 @@
+/**
+ * PANORAMYX - Programming pArallel coNstraint sOlveRs mAde aMazingly easY.
+ * Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see {@link http://www.gnu.org/licenses}.
+ */
+
+/**
+ * @file SerialExecutor.hpp
+ * @brief Executes tasks one after the other on a single long-lived thread.
+ *
+ * @author Thibault Falque
+ * @author Romain Wallon
+ *
+ * @copyright Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#ifndef PANORAMYX_SERIALEXECUTOR_HPP
+#define PANORAMYX_SERIALEXECUTOR_HPP
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace Panoramyx {
+
+    /**
+     * The SerialExecutor executes tasks one after the other, in the order in which they
+     * have been submitted, on a single thread that lives as long as the executor.
+     * This avoids creating a thread (and attaching it to the JVM) for each task.
+     */
+    class SerialExecutor {
+
+    private:
+
+        /**
+         * The tasks that have been submitted but not started yet.
+         */
+        std::deque<std::function<void()>> tasks;
+
+        /**
+         * The mutex protecting the access to the tasks.
+         */
+        std::mutex mutex;
+
+        /**
+         * The condition used to wake up the thread when a task is submitted, or when
+         * the executor is shut down.
+         */
+        std::condition_variable condition;
+
+        /**
+         * Whether this executor has been shut down.
+         */
+        bool stopped;
+
+        /**
+         * The function to execute on the thread of this executor before it terminates.
+         */
+        std::function<void()> onExit;
+
+        /**
+         * The thread executing the tasks.
+         * It is declared last, so that it starts once everything else is initialized.
+         */
+        std::thread worker;
+
+        /**
+         * Executes the submitted tasks until this executor is shut down.
+         */
+        void run();
+
+    public:
+
+        /**
+         * Creates a new SerialExecutor, and starts its thread.
+         *
+         * @param onExit The function to execute on the thread of the executor before it
+         *        terminates (e.g., to detach it from the JVM).
+         */
+        explicit SerialExecutor(std::function<void()> onExit = nullptr);
+
+        /**
+         * Destroys this SerialExecutor, after the tasks already submitted have been executed.
+         */
+        ~SerialExecutor();
+
+        /**
+         * Submits a task to this executor.
+         * An exception thrown by the task is logged, and does not prevent the execution
+         * of the next tasks.
+         *
+         * @param task The task to execute.
+         *
+         * @throws IllegalStateException If this executor has been shut down.
+         */
+        void execute(std::function<void()> task);
+
+        /**
+         * Cancels the tasks that have been submitted but not started yet.
+         * The task that is currently executed (if any) is not interrupted.
+         *
+         * @return The number of cancelled tasks.
+         */
+        unsigned long cancelPending();
+
+        /**
+         * Shuts down this executor, and waits for the tasks already submitted to be executed.
+         * No task can be submitted afterwards.
+         */
+        void shutdown();
+
+    };
+
+}
+
+#endif
@@ -0,0 +1,138 @@
+/**
+ * PANORAMYX - Programming pArallel coNstraint sOlveRs mAde aMazingly easY.
+ * Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see {@link http://www.gnu.org/licenses}.
+ */
+
+/**
+ * @file CompressedNetworkCommunication.cpp
+ * @brief Provides a communication compressing the large messages sent by another communication.
+ *
+ * @author Thibault Falque
+ * @author Romain Wallon
+ *
+ * @copyright Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#include <loguru.hpp>
+
+#include <crillab-panoramyx/network/CompressedNetworkCommunication.hpp>
+#include <crillab-panoramyx/network/CompressedReceiveRequest.hpp>
+#include <crillab-panoramyx/network/MessageCompressor.hpp>
+#include <crillab-panoramyx/network/MessageHandle.hpp>
+#include <crillab-panoramyx/network/MessagePool.hpp>
+
+using namespace std;
+
+using namespace Panoramyx;
+
+CompressedNetworkCommunication::CompressedNetworkCommunication(INetworkCommunication *decorated,
+                                                               unsigned long threshold) :
+        NetworkCommunicationDecorator(decorated),
+        threshold(threshold),
+        nbCompressed(0),
+        originalBytes(0),
+        compressedBytes(0) {
+    // Nothing to do: everything is already initialized.
+}
+
+Message *CompressedNetworkCommunication::receive(int tag, int src) {
+    return decompress(decorated->receive(tag, src));
+}
+
+void CompressedNetworkCommunication::send(Message *message, int dest) {
+    auto *compressed = compress(message);
+    if (compressed == nullptr) {
+        decorated->send(message, dest);
+        return;
+    }
+    decorated->send(compressed, dest);
+    MessagePool::release(compressed);
+}
+
+void CompressedNetworkCommunication::transfer(Message *message, int dest) {
+    auto *compressed = compress(message);
+    if (compressed == nullptr) {
+        decorated->transfer(message, dest);
+        return;
+    }
+    MessagePool::release(message);
+    decorated->transfer(compressed, dest);
+}
+
+INetworkRequest *CompressedNetworkCommunication::irecv(int tag, int src) {
+    return new CompressedReceiveRequest(decorated->irecv(tag, src));
+}
+
+INetworkRequest *CompressedNetworkCommunication::isend(Message *message, int dest) {
+    auto *compressed = compress(message);
+    if (compressed == nullptr) {
+        return decorated->isend(message, dest);
+    }
+    MessagePool::release(message);
+    return decorated->isend(compressed, dest);
+}
+
+void CompressedNetworkCommunication::broadcast(Message *message, const vector<int> &ranks) {
+    auto *compressed = compress(message);
+    if (compressed == nullptr) {
+        decorated->broadcast(message, ranks);
+        return;
+    }
+    decorated->broadcast(compressed, ranks);
+    MessagePool::release(compressed);
+}
+
+void CompressedNetworkCommunication::finalize() {
+    // The decorated communication may wait for its threads, which may still compress messages.
+    int id = getId();
+    decorated->finalize();
+
+    if (nbCompressed > 0) {
+        LOG_F(INFO, "communicator #%d compressed %lu messages from %lu to %lu bytes (ratio %.2f)",
+              id, nbCompressed.load(), originalBytes.load(), compressedBytes.load(),
+              (double) originalBytes / (double) compressedBytes);
+    }
+}
+
+Message *CompressedNetworkCommunication::decompress(Message *message) {
+    if ((message == nullptr) || !MessageCompressor::isCompressed(message)) {
+        return message;
+    }
+    MessageHandle received(message);
+    return MessageCompressor::decompress(message);
+}
+
+Message *CompressedNetworkCommunication::compress(const Message *message) {
+    if (message->size < threshold) {
+        return nullptr;
+    }
+
+    auto *compressed = MessageCompressor::compress(message);
+    if (compressed == nullptr) {
+        LOG_F(INFO, "message '%s' of %lu bytes is not compressible", nameOf(message->opcode), message->size);
+        return nullptr;
+    }
+
+    nbCompressed++;
+    originalBytes += message->size;
+    compressedBytes += compressed->size;
+    LOG_F(INFO, "compressed message '%s' from %lu to %lu bytes (ratio %.2f)", nameOf(message->opcode),
+          message->size, compressed->size, (double) message->size / (double) compressed->size);
+    return compressed;
+}
@@ -0,0 +1,234 @@
+/**
+ * PANORAMYX - Programming pArallel coNstraint sOlveRs mAde aMazingly easY.
+ * Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see {@link http://www.gnu.org/licenses}.
+ */
+
+/**
+ * @file HybridCommunication.cpp
+ * @brief An implementation of INetworkCommunication combining MPI between processes and threads inside them.
+ *
+ * @author Thibault Falque
+ * @author Romain Wallon
+ *
+ * @copyright Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#include <crillab-except/except.hpp>
+
+#include <crillab-panoramyx/network/CompletedNetworkRequest.hpp>
+#include <crillab-panoramyx/network/HybridCommunication.hpp>
+#include <crillab-panoramyx/network/MailboxReceiveRequest.hpp>
+#include <crillab-panoramyx/network/MessagePool.hpp>
+#include <crillab-panoramyx/network/MPISendRequest.hpp>
+
+using namespace std;
+
+using namespace Except;
+using namespace Panoramyx;
+
+thread_local int HybridCommunication::threadIndex = 0;
+
+HybridCommunication::HybridCommunication(int nbThreads, unsigned long chunkSize) :
+        nbThreads(nbThreads),
+        communicator(MPI_COMM_NULL),
+        chunkCommunicator(MPI_COMM_NULL),
+        chunkSize(max(chunkSize, (unsigned long) sizeof(Message))),
+        rank(-1),
+        worldSize(-1) {
+    // Using a dedicated communicator, as MPI tags have a specific meaning here.
+    MPI_Comm_dup(MPI_COMM_WORLD, &communicator);
+    MPI_Comm_set_errhandler(communicator, MPI_ERRORS_ARE_FATAL);
+    MPI_Comm_rank(communicator, &rank);
+    MPI_Comm_size(communicator, &worldSize);
+    MPI_Comm_dup(communicator, &chunkCommunicator);
+
+    // The identifier of the destination is used as MPI tag, and nbProcesses() stops the progress thread.
+    int *tagUpperBound;
+    int flag;
+    MPI_Comm_get_attr(communicator, MPI_TAG_UB, &tagUpperBound, &flag);
+    if (flag && (*tagUpperBound < nbProcesses())) {
+        throw IllegalArgumentException("too many communicators to be identified by MPI tags");
+    }
+
+    for (int i = 0; i < nbThreads; i++) {
+        mailboxes.push_back(new MessageMailbox());
+    }
+}
+
+HybridCommunication::~HybridCommunication() {
+    for (auto *mailbox : mailboxes) {
+        delete mailbox;
+    }
+}
+
+int HybridCommunication::getId() {
+    return (rank * nbThreads) + threadIndex;
+}
+
+int HybridCommunication::nbProcesses() {
+    return worldSize * nbThreads;
+}
+
+bool HybridCommunication::isLocal(int id) const {
+    return (id / nbThreads) == rank;
+}
+
+MessageMailbox *HybridCommunication::mailboxOf(int id) {
+    return mailboxes[id % nbThreads];
+}
+
+void HybridCommunication::start(function<void()> runnable) {
+    progressThread = thread([this]() {
+        progress();
+    });
+
+    for (int i = 0; i < nbThreads; i++) {
+        threads.emplace_back([runnable, i]() {
+            threadIndex = i;
+            runnable();
+        });
+    }
+}
+
+function<void()> HybridCommunication::attach(function<void()> runnable) {
+    int current = threadIndex;
+    return [runnable = std::move(runnable), current]() {
+        threadIndex = current;
+        runnable();
+    };
+}
+
+void HybridCommunication::progress() {
+    for (;;) {
+        MPI_Message handle;
+        MPI_Status status;
+        MPI_Mprobe(MPI_ANY_SOURCE, MPI_ANY_TAG, communicator, &handle, &status);
+        int count;
+        MPI_Get_count(&status, MPI_BYTE, &count);
+        if (status.MPI_TAG == nbProcesses()) {
+            // This communication is being finalized.
+            MPI_Mrecv(nullptr, 0, MPI_BYTE, &handle, MPI_STATUS_IGNORE);
+            return;
+        }
+
+        auto *message = MessagePool::allocate(count);
+        MPI_Mrecv(message, count, MPI_BYTE, &handle, MPI_STATUS_IGNORE);
+
+        // Receiving the remaining chunks of the message, if any.
+        unsigned long received = count;
+        unsigned long total = sizeof(Message) + message->size;
+        if (received < total) {
+            message = MessagePool::reallocate(message, total);
+            auto *bytes = reinterpret_cast<char *>(message);
+            while (received < total) {
+                int length = (int) min(chunkSize, total - received);
+                MPI_Recv(bytes + received, length, MPI_BYTE, status.MPI_SOURCE, status.MPI_TAG,
+                         chunkCommunicator, MPI_STATUS_IGNORE);
+                received += length;
+            }
+        }
+        mailboxOf(status.MPI_TAG)->deliver(message);
+    }
+}
+
+Message *HybridCommunication::receive(int tag, int src) {
+    return completeReceive(mailboxOf(getId())->receive(tag, src));
+}
+
+void HybridCommunication::send(Message *message, int dest) {
+    message->src = getId();
+    unsigned long total = sizeof(Message) + message->size;
+    if (isLocal(dest)) {
+        // The caller keeps its message, so the destination receives a copy.
+        auto *copiedMessage = MessagePool::allocate(total);
+        memcpy(copiedMessage, message, total);
+        mailboxOf(dest)->deliver(copiedMessage);
+        return;
+    }
+
+    sendRemote(message, dest);
+}
+
+void HybridCommunication::sendRemote(const Message *message, int dest) {
+    unsigned long total = sizeof(Message) + message->size;
+    if (total <= chunkSize) {
+        MPI_Send(message, (int) total, MPI_BYTE, dest / nbThreads, dest, communicator);
+        return;
+    }
+
+    // The message is too large, so it is split into chunks.
+    scoped_lock lock(chunkMutex);
+    auto *bytes = reinterpret_cast<const char *>(message);
+    MPI_Send(bytes, (int) chunkSize, MPI_BYTE, dest / nbThreads, dest, communicator);
+    for (unsigned long sent = chunkSize; sent < total;) {
+        int length = (int) min(chunkSize, total - sent);
+        MPI_Send(bytes + sent, length, MPI_BYTE, dest / nbThreads, dest, chunkCommunicator);
+        sent += length;
+    }
+}
+
+void HybridCommunication::transfer(Message *message, int dest) {
+    if (isLocal(dest)) {
+        message->src = getId();
+        mailboxOf(dest)->deliver(message);
+        return;
+    }
+
+    send(message, dest);
+    MessagePool::release(message);
+}
+
+INetworkRequest *HybridCommunication::irecv(int tag, int src) {
+    return new MailboxReceiveRequest(this, mailboxOf(getId()), tag, src);
+}
+
+INetworkRequest *HybridCommunication::isend(Message *message, int dest) {
+    if (isLocal(dest)) {
+        transfer(message, dest);
+        return new CompletedNetworkRequest();
+    }
+
+    message->src = getId();
+    unsigned long total = sizeof(Message) + message->size;
+    if (total > chunkSize) {
+        // Chunked messages are sent synchronously to keep their chunks together.
+        sendRemote(message, dest);
+        MessagePool::release(message);
+        return new CompletedNetworkRequest();
+    }
+
+    MPI_Request request;
+    MPI_Isend(message, (int) total, MPI_BYTE, dest / nbThreads, dest, communicator, &request);
+    return new MPISendRequest(request, message);
+}
+
+void HybridCommunication::finalize() {
+    for (auto &t : threads) {
+        t.join();
+    }
+
+    // Once all processes are done, nothing is sent anymore and the progress threads can be stopped.
+    MPI_Barrier(communicator);
+    MPI_Send(nullptr, 0, MPI_BYTE, rank, nbProcesses(), communicator);
+    progressThread.join();
+
+    MPI_Comm_free(&chunkCommunicator);
+    MPI_Comm_free(&communicator);
+    MPI_Finalize();
+}
@@ -0,0 +1,120 @@
+/**
+ * PANORAMYX - Programming pArallel coNstraint sOlveRs mAde aMazingly easY.
+ * Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see {@link http://www.gnu.org/licenses}.
+ */
+
+/**
+ * @file INetworkCommunication.cpp
+ * @brief Defines a strategy for network communication.
+ *
+ * @author Thibault Falque
+ * @author Romain Wallon
+ *
+ * @copyright Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#include <crillab-panoramyx/network/INetworkCommunication.hpp>
+#include <crillab-panoramyx/network/MessagePool.hpp>
+
+using namespace std;
+
+using namespace Panoramyx;
+
+function<void()> INetworkCommunication::attach(function<void()> runnable) {
+    return runnable;
+}
+
+void INetworkCommunication::transfer(Message *message, int dest) {
+    send(message, dest);
+    MessagePool::release(message);
+}
+
+void INetworkCommunication::waitAll(const vector<INetworkRequest *> &requests) {
+    for (auto *request : requests) {
+        request->wait();
+    }
+}
+
+int INetworkCommunication::testAny(const vector<INetworkRequest *> &requests) {
+    for (int i = 0; i < (int) requests.size(); i++) {
+        if (requests[i]->test()) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+void INetworkCommunication::broadcast(Message *message, const vector<int> &ranks) {
+    vector<int> destinations;
+    destinations.reserve(ranks.size());
+    for (int rank : ranks) {
+        if (rank != getId()) {
+            destinations.push_back(rank);
+        }
+    }
+    forward(message, getId(), destinations);
+}
+
+Message *INetworkCommunication::completeReceive(Message *message) {
+    if ((message == nullptr) || ((message->flags & PANO_FLAG_BROADCAST) == 0)) {
+        return message;
+    }
+
+    // Removing the trailer describing the part of the tree under this communicator.
+    unsigned nbRanks;
+    char *end = message->parameters + message->size - sizeof(nbRanks);
+    memcpy(&nbRanks, end, sizeof(nbRanks));
+    char *trailer = end - (nbRanks + 1) * sizeof(int);
+    int root;
+    memcpy(&root, trailer, sizeof(root));
+    vector<int> ranks(nbRanks);
+    for (unsigned i = 0; i < nbRanks; i++) {
+        memcpy(&ranks[i], trailer + (i + 1) * sizeof(int), sizeof(int));
+    }
+    message->size = trailer - message->parameters;
+    message->flags &= ~PANO_FLAG_BROADCAST;
+    message->src = root;
+
+    forward(message, root, ranks);
+    return message;
+}
+
+void INetworkCommunication::forward(const Message *message, int root, vector<int> &ranks) {
+    while (!ranks.empty()) {
+        // The child is responsible for forwarding the message to the ranks following it.
+        auto middle = ranks.size() / 2;
+        int child = ranks[middle];
+        auto nbRanks = (unsigned) (ranks.size() - middle - 1);
+        unsigned long trailerSize = (nbRanks + 1) * sizeof(int) + sizeof(nbRanks);
+
+        auto *copy = MessagePool::allocate(sizeof(Message) + message->size + trailerSize);
+        memcpy(copy, message, sizeof(Message) + message->size);
+        char *trailer = copy->parameters + message->size;
+        memcpy(trailer, &root, sizeof(root));
+        for (unsigned i = 0; i < nbRanks; i++) {
+            memcpy(trailer + (i + 1) * sizeof(int), &ranks[middle + 1 + i], sizeof(int));
+        }
+        memcpy(trailer + (nbRanks + 1) * sizeof(int), &nbRanks, sizeof(nbRanks));
+        copy->size += trailerSize;
+        copy->flags |= PANO_FLAG_BROADCAST;
+        transfer(copy, child);
+
+        ranks.resize(middle);
+    }
+}
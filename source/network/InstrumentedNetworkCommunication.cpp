@@ -0,0 +1,251 @@
+/**
+ * PANORAMYX - Programming pArallel coNstraint sOlveRs mAde aMazingly easY.
+ * Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see {@link http://www.gnu.org/licenses}.
+ */
+
+/**
+ * @file InstrumentedNetworkCommunication.cpp
+ * @brief Provides a communication recording metrics about the messages exchanged by another communication.
+ *
+ * @author Thibault Falque
+ * @author Romain Wallon
+ *
+ * @copyright Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#include <bit>
+#include <chrono>
+#include <fstream>
+#include <set>
+
+#include <loguru.hpp>
+
+#include <crillab-panoramyx/network/InstrumentedNetworkCommunication.hpp>
+#include <crillab-panoramyx/network/InstrumentedReceiveRequest.hpp>
+
+using namespace std;
+using namespace std::chrono;
+
+using namespace Panoramyx;
+
+/**
+ * Computes the number of microseconds elapsed since the given time.
+ *
+ * @param start The time to compute the elapsed time from.
+ *
+ * @return The number of elapsed microseconds.
+ */
+static unsigned long microsSince(steady_clock::time_point start) {
+    return (unsigned long) duration_cast<microseconds>(steady_clock::now() - start).count();
+}
+
+/**
+ * Writes a latency histogram in JSON.
+ *
+ * @param output The stream to write to.
+ * @param histogram The histogram to write.
+ */
+static void writeHistogram(ostream &output, const InstrumentedNetworkCommunication::LatencyHistogram &histogram) {
+    output << "{\"total_us\": " << histogram.totalMicros << ", \"max_us\": " << histogram.maxMicros
+           << ", \"buckets\": [";
+    for (unsigned i = 0; i < histogram.buckets.size(); i++) {
+        output << (i == 0 ? "" : ", ") << histogram.buckets[i];
+    }
+    output << "]}";
+}
+
+/**
+ * Writes traffic statistics in JSON, as the last fields of an object.
+ *
+ * @param output The stream to write to.
+ * @param statistics The statistics to write.
+ */
+static void writeTraffic(ostream &output, const InstrumentedNetworkCommunication::TrafficStatistics &statistics) {
+    output << ", \"count\": " << statistics.count << ", \"bytes\": " << statistics.bytes << ", \"latency\": ";
+    writeHistogram(output, statistics.latency);
+    output << "}";
+}
+
+void InstrumentedNetworkCommunication::LatencyHistogram::record(unsigned long micros) {
+    totalMicros += micros;
+    maxMicros = max(maxMicros, micros);
+    buckets[min((unsigned long) bit_width(micros), (unsigned long) PANO_LATENCY_BUCKETS - 1)]++;
+}
+
+InstrumentedNetworkCommunication::InstrumentedNetworkCommunication(INetworkCommunication *decorated,
+                                                                   string reportFile) :
+        NetworkCommunicationDecorator(decorated),
+        reportFile(move(reportFile)),
+        statisticsMutex(),
+        messageStatistics(),
+        peerStatistics(),
+        broadcastStatistics(),
+        blockedStatistics() {
+    // Nothing to do: everything is already initialized.
+}
+
+Message *InstrumentedNetworkCommunication::receive(int tag, int src) {
+    auto start = steady_clock::now();
+    auto *message = decorated->receive(tag, src);
+    auto micros = microsSince(start);
+    recordReceived(message, micros, micros);
+    return message;
+}
+
+void InstrumentedNetworkCommunication::send(Message *message, int dest) {
+    auto start = steady_clock::now();
+    decorated->send(message, dest);
+    record(true, message->opcode, message->tag, sizeof(Message) + message->size, dest, microsSince(start));
+}
+
+void InstrumentedNetworkCommunication::transfer(Message *message, int dest) {
+    // The message must not be read once transferred.
+    auto opcode = message->opcode;
+    auto tag = message->tag;
+    auto bytes = sizeof(Message) + message->size;
+    auto start = steady_clock::now();
+    decorated->transfer(message, dest);
+    record(true, opcode, tag, bytes, dest, microsSince(start));
+}
+
+INetworkRequest *InstrumentedNetworkCommunication::irecv(int tag, int src) {
+    return new InstrumentedReceiveRequest(this, decorated->irecv(tag, src));
+}
+
+INetworkRequest *InstrumentedNetworkCommunication::isend(Message *message, int dest) {
+    // The message is owned by the request once posted.
+    auto opcode = message->opcode;
+    auto tag = message->tag;
+    auto bytes = sizeof(Message) + message->size;
+    auto start = steady_clock::now();
+    auto *request = decorated->isend(message, dest);
+    record(true, opcode, tag, bytes, dest, microsSince(start));
+    return request;
+}
+
+void InstrumentedNetworkCommunication::broadcast(Message *message, const vector<int> &ranks) {
+    auto start = steady_clock::now();
+    decorated->broadcast(message, ranks);
+    auto micros = microsSince(start);
+
+    // The messages relaying the broadcast are not visible from here, so only the operation is recorded.
+    int id = getId();
+    scoped_lock lock(statisticsMutex);
+    auto &statistics = broadcastStatistics[{id, message->opcode, message->tag}];
+    statistics.count++;
+    statistics.bytes += sizeof(Message) + message->size;
+    statistics.latency.record(micros);
+    for (int rank : ranks) {
+        if (rank != id) {
+            statistics.recipients++;
+        }
+    }
+}
+
+void InstrumentedNetworkCommunication::finalize() {
+    // The decorated communication may wait for its threads, which must all be recorded.
+    auto path = reportFile + "_" + to_string(getId()) + ".json";
+    decorated->finalize();
+
+    ofstream output(path);
+    writeReport(output);
+    if (output) {
+        LOG_F(INFO, "network report written to %s", path.c_str());
+    } else {
+        LOG_F(ERROR, "could not write network report to %s", path.c_str());
+    }
+}
+
+void InstrumentedNetworkCommunication::recordReceived(const Message *message, unsigned long latencyMicros,
+                                                      unsigned long blockedMicros) {
+    record(false, message->opcode, message->tag, sizeof(Message) + message->size, message->src, latencyMicros);
+    int id = getId();
+    scoped_lock lock(statisticsMutex);
+    blockedStatistics[id].record(blockedMicros);
+}
+
+void InstrumentedNetworkCommunication::record(bool sent, MessageOpcode opcode, int tag, unsigned long bytes,
+                                              int peer, unsigned long micros) {
+    int id = getId();
+    scoped_lock lock(statisticsMutex);
+    for (auto *statistics : {&messageStatistics[{id, sent, opcode, tag}], &peerStatistics[{id, sent, peer}]}) {
+        statistics->count++;
+        statistics->bytes += bytes;
+        statistics->latency.record(micros);
+    }
+}
+
+void InstrumentedNetworkCommunication::writeReport(ostream &output) {
+    scoped_lock lock(statisticsMutex);
+
+    // In thread mode, the same instance is shared by all the communicators.
+    set<int> ids;
+    for (auto &[key, statistics] : peerStatistics) {
+        ids.insert(get<0>(key));
+    }
+    for (auto &[key, statistics] : broadcastStatistics) {
+        ids.insert(get<0>(key));
+    }
+
+    output << "{\"communicators\": [";
+    const char *separator = "";
+    for (int id : ids) {
+        output << separator << "\n  {\"id\": " << id << ", \"blocked\": ";
+        writeHistogram(output, blockedStatistics[id]);
+        separator = ",";
+
+        output << ",\n   \"messages\": [";
+        const char *innerSeparator = "";
+        for (auto &[key, statistics] : messageStatistics) {
+            auto &[communicator, sent, opcode, tag] = key;
+            if (communicator == id) {
+                output << innerSeparator << "\n    {\"direction\": \"" << (sent ? "sent" : "received")
+                       << "\", \"opcode\": \"" << nameOf(opcode) << "\", \"tag\": " << tag;
+                writeTraffic(output, statistics);
+                innerSeparator = ",";
+            }
+        }
+
+        output << "],\n   \"peers\": [";
+        innerSeparator = "";
+        for (auto &[key, statistics] : peerStatistics) {
+            auto &[communicator, sent, peer] = key;
+            if (communicator == id) {
+                output << innerSeparator << "\n    {\"direction\": \"" << (sent ? "sent" : "received")
+                       << "\", \"peer\": " << peer;
+                writeTraffic(output, statistics);
+                innerSeparator = ",";
+            }
+        }
+
+        output << "],\n   \"broadcasts\": [";
+        innerSeparator = "";
+        for (auto &[key, statistics] : broadcastStatistics) {
+            auto &[communicator, opcode, tag] = key;
+            if (communicator == id) {
+                output << innerSeparator << "\n    {\"opcode\": \"" << nameOf(opcode) << "\", \"tag\": " << tag
+                       << ", \"recipients\": " << statistics.recipients;
+                writeTraffic(output, statistics);
+                innerSeparator = ",";
+            }
+        }
+        output << "]}";
+    }
+    output << "\n]}\n";
+}
@@ -0,0 +1,84 @@
+/**
+ * PANORAMYX - Programming pArallel coNstraint sOlveRs mAde aMazingly easY.
+ * Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see {@link http://www.gnu.org/licenses}.
+ */
+
+/**
+ * @file InstrumentedReceiveRequest.cpp
+ * @brief Represents a message being received by an InstrumentedNetworkCommunication.
+ *
+ * @author Thibault Falque
+ * @author Romain Wallon
+ *
+ * @copyright Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#include <crillab-panoramyx/network/InstrumentedNetworkCommunication.hpp>
+#include <crillab-panoramyx/network/InstrumentedReceiveRequest.hpp>
+
+using namespace std::chrono;
+
+using namespace Panoramyx;
+
+InstrumentedReceiveRequest::InstrumentedReceiveRequest(InstrumentedNetworkCommunication *communication,
+                                                       INetworkRequest *request) :
+        communication(communication),
+        request(request),
+        start(steady_clock::now()),
+        latencyMicros(0),
+        blockedMicros(0),
+        completed(false) {
+    // Nothing to do: everything is already initialized.
+}
+
+InstrumentedReceiveRequest::~InstrumentedReceiveRequest() {
+    delete request;
+}
+
+bool InstrumentedReceiveRequest::test() {
+    if (request->test()) {
+        complete();
+        return true;
+    }
+    return false;
+}
+
+void InstrumentedReceiveRequest::wait() {
+    if (!completed) {
+        auto waitStart = steady_clock::now();
+        request->wait();
+        blockedMicros = (unsigned long) duration_cast<microseconds>(steady_clock::now() - waitStart).count();
+        complete();
+    }
+}
+
+Message *InstrumentedReceiveRequest::getMessage() {
+    auto *message = request->getMessage();
+    if (message != nullptr) {
+        communication->recordReceived(message, latencyMicros, blockedMicros);
+    }
+    return message;
+}
+
+void InstrumentedReceiveRequest::complete() {
+    if (!completed) {
+        latencyMicros = (unsigned long) duration_cast<microseconds>(steady_clock::now() - start).count();
+        completed = true;
+    }
+}
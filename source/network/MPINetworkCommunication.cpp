@@ -29,12 +29,14 @@
  * @license This project is released under the GNU LGPL3 License.
  */
 
-#include <cstdlib>
+#include <algorithm>
 #include <functional>
 
-#include <mpi.h>
-
+#include <crillab-panoramyx/network/CompletedNetworkRequest.hpp>
+#include <crillab-panoramyx/network/MessagePool.hpp>
 #include <crillab-panoramyx/network/MPINetworkCommunication.hpp>
+#include <crillab-panoramyx/network/MPIReceiveRequest.hpp>
+#include <crillab-panoramyx/network/MPISendRequest.hpp>
 
 using namespace std;
 
@@ -42,10 +44,16 @@ using namespace Panoramyx;
 
 INetworkCommunication *MPINetworkCommunication::instance = nullptr;
 
-INetworkCommunication *MPINetworkCommunication::getInstance() {
+MPINetworkCommunication::MPINetworkCommunication(unsigned long chunkSize) :
+        chunkCommunicator(MPI_COMM_NULL),
+        chunkSize(max(chunkSize, (unsigned long) sizeof(Message))) {
+    MPI_Comm_set_errhandler(MPI_COMM_WORLD, MPI_ERRORS_ARE_FATAL);
+    MPI_Comm_dup(MPI_COMM_WORLD, &chunkCommunicator);
+}
+
+INetworkCommunication *MPINetworkCommunication::getInstance(unsigned long chunkSize) {
     if (instance == nullptr) {
-        instance = new MPINetworkCommunication();
-        MPI_Comm_set_errhandler(MPI_COMM_WORLD, MPI_ERRORS_ARE_FATAL);
+        instance = new MPINetworkCommunication(chunkSize);
     }
     return instance;
 }
@@ -68,17 +76,76 @@ void MPINetworkCommunication::start(function<void()> runnable) {
     runnable();
 }
 
-Message *MPINetworkCommunication::receive(int tag, int src, unsigned long size) {
-    auto *message = static_cast<Message *>(malloc(size));
-    MPI_Recv(message, (int) size, MPI_BYTE, src, tag, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
-    return message;
+Message *MPINetworkCommunication::receive(int tag, int src) {
+    // Matching the message first ensures that no other thread can steal it.
+    MPI_Message handle;
+    MPI_Status status;
+    MPI_Mprobe(src, tag, MPI_COMM_WORLD, &handle, &status);
+    return receive(handle, status);
+}
+
+Message *MPINetworkCommunication::receive(MPI_Message &handle, MPI_Status &status) {
+    int count;
+    MPI_Get_count(&status, MPI_BYTE, &count);
+    auto *message = MessagePool::allocate(count);
+    MPI_Mrecv(message, count, MPI_BYTE, &handle, MPI_STATUS_IGNORE);
+
+    // Receiving the remaining chunks of the message, if any.
+    // They are matched by source and tag, which are received by this thread only.
+    unsigned long received = count;
+    unsigned long total = sizeof(Message) + message->size;
+    if (received < total) {
+        message = MessagePool::reallocate(message, total);
+        auto *bytes = reinterpret_cast<char *>(message);
+        while (received < total) {
+            int length = (int) min(chunkSize, total - received);
+            MPI_Recv(bytes + received, length, MPI_BYTE, status.MPI_SOURCE, status.MPI_TAG,
+                     chunkCommunicator, MPI_STATUS_IGNORE);
+            received += length;
+        }
+    }
+    return completeReceive(message);
 }
 
 void MPINetworkCommunication::send(Message *message, int dest) {
     message->src = getId();
-    MPI_Send(message, (int) (sizeof(Message) + message->size), MPI_BYTE, dest, message->tag, MPI_COMM_WORLD);
+    unsigned long total = sizeof(Message) + message->size;
+    if (total <= chunkSize) {
+        MPI_Send(message, (int) total, MPI_BYTE, dest, message->tag, MPI_COMM_WORLD);
+        return;
+    }
+
+    // The message is too large, so it is split into chunks.
+    scoped_lock lock(chunkMutex);
+    auto *bytes = reinterpret_cast<const char *>(message);
+    MPI_Send(bytes, (int) chunkSize, MPI_BYTE, dest, message->tag, MPI_COMM_WORLD);
+    for (unsigned long sent = chunkSize; sent < total;) {
+        int length = (int) min(chunkSize, total - sent);
+        MPI_Send(bytes + sent, length, MPI_BYTE, dest, message->tag, chunkCommunicator);
+        sent += length;
+    }
+}
+
+INetworkRequest *MPINetworkCommunication::irecv(int tag, int src) {
+    return new MPIReceiveRequest(this, tag, src);
+}
+
+INetworkRequest *MPINetworkCommunication::isend(Message *message, int dest) {
+    message->src = getId();
+    unsigned long total = sizeof(Message) + message->size;
+    if (total > chunkSize) {
+        // Chunked messages are sent synchronously to keep their chunks together.
+        send(message, dest);
+        MessagePool::release(message);
+        return new CompletedNetworkRequest();
+    }
+
+    MPI_Request request;
+    MPI_Isend(message, (int) total, MPI_BYTE, dest, message->tag, MPI_COMM_WORLD, &request);
+    return new MPISendRequest(request, message);
 }
 
 void MPINetworkCommunication::finalize() {
+    MPI_Comm_free(&chunkCommunicator);
     MPI_Finalize();
 }
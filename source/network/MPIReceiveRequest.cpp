@@ -0,0 +1,78 @@
+/**
+ * PANORAMYX - Programming pArallel coNstraint sOlveRs mAde aMazingly easY.
+ * Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see {@link http://www.gnu.org/licenses}.
+ */
+
+/**
+ * @file MPIReceiveRequest.cpp
+ * @brief A pending non-blocking receive performed with MPI.
+ *
+ * @author Thibault Falque
+ * @author Romain Wallon
+ *
+ * @copyright Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#include <mpi.h>
+
+#include <crillab-panoramyx/network/MessagePool.hpp>
+#include <crillab-panoramyx/network/MPINetworkCommunication.hpp>
+#include <crillab-panoramyx/network/MPIReceiveRequest.hpp>
+
+using namespace Panoramyx;
+
+MPIReceiveRequest::MPIReceiveRequest(MPINetworkCommunication *communication, int tag, int src) :
+        communication(communication),
+        tag(tag),
+        src(src),
+        completed(false),
+        message(nullptr) {
+    // Nothing to do: everything is already initialized.
+}
+
+MPIReceiveRequest::~MPIReceiveRequest() {
+    MessagePool::release(message);
+}
+
+bool MPIReceiveRequest::test() {
+    if (!completed) {
+        int flag = 0;
+        MPI_Message handle;
+        MPI_Status status;
+        MPI_Improbe(src, tag, MPI_COMM_WORLD, &flag, &handle, &status);
+        if (flag) {
+            message = communication->receive(handle, status);
+            completed = true;
+        }
+    }
+    return completed;
+}
+
+void MPIReceiveRequest::wait() {
+    if (!completed) {
+        message = communication->receive(tag, src);
+        completed = true;
+    }
+}
+
+Message *MPIReceiveRequest::getMessage() {
+    auto *received = message;
+    message = nullptr;
+    return received;
+}
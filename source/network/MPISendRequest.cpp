@@ -0,0 +1,71 @@
+/**
+ * PANORAMYX - Programming pArallel coNstraint sOlveRs mAde aMazingly easY.
+ * Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see {@link http://www.gnu.org/licenses}.
+ */
+
+/**
+ * @file MPISendRequest.cpp
+ * @brief A pending non-blocking send performed with MPI.
+ *
+ * @author Thibault Falque
+ * @author Romain Wallon
+ *
+ * @copyright Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#include <crillab-panoramyx/network/MessagePool.hpp>
+#include <crillab-panoramyx/network/MPISendRequest.hpp>
+
+using namespace Panoramyx;
+
+MPISendRequest::MPISendRequest(MPI_Request request, Message *message) :
+        request(request),
+        message(message) {
+    // Nothing to do: everything is already initialized.
+}
+
+MPISendRequest::~MPISendRequest() {
+    wait();
+}
+
+bool MPISendRequest::test() {
+    if (message == nullptr) {
+        return true;
+    }
+
+    int flag = 0;
+    MPI_Test(&request, &flag, MPI_STATUS_IGNORE);
+    if (flag) {
+        MessagePool::release(message);
+        message = nullptr;
+    }
+    return flag;
+}
+
+void MPISendRequest::wait() {
+    if (message != nullptr) {
+        MPI_Wait(&request, MPI_STATUS_IGNORE);
+        MessagePool::release(message);
+        message = nullptr;
+    }
+}
+
+Message *MPISendRequest::getMessage() {
+    return nullptr;
+}
@@ -0,0 +1,71 @@
+/**
+ * PANORAMYX - Programming pArallel coNstraint sOlveRs mAde aMazingly easY.
+ * Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see {@link http://www.gnu.org/licenses}.
+ */
+
+/**
+ * @file MailboxReceiveRequest.cpp
+ * @brief A pending non-blocking receive from a message mailbox.
+ *
+ * @author Thibault Falque
+ * @author Romain Wallon
+ *
+ * @copyright Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#include <crillab-panoramyx/network/MessagePool.hpp>
+#include <crillab-panoramyx/network/MailboxReceiveRequest.hpp>
+
+using namespace Panoramyx;
+
+MailboxReceiveRequest::MailboxReceiveRequest(INetworkCommunication *communication,
+                                             MessageMailbox *mailbox, int tag, int src) :
+        communication(communication),
+        mailbox(mailbox),
+        tag(tag),
+        src(src),
+        completed(false),
+        message(nullptr) {
+    // Nothing to do: everything is already initialized.
+}
+
+MailboxReceiveRequest::~MailboxReceiveRequest() {
+    MessagePool::release(message);
+}
+
+bool MailboxReceiveRequest::test() {
+    if (!completed) {
+        message = communication->completeReceive(mailbox->tryReceive(tag, src));
+        completed = (message != nullptr);
+    }
+    return completed;
+}
+
+void MailboxReceiveRequest::wait() {
+    if (!completed) {
+        message = communication->completeReceive(mailbox->receive(tag, src));
+        completed = true;
+    }
+}
+
+Message *MailboxReceiveRequest::getMessage() {
+    auto *received = message;
+    message = nullptr;
+    return received;
+}
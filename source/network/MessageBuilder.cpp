@@ -29,26 +29,72 @@
  * @license This project is released under the GNU LGPL3 License.
  */
 
+#include <algorithm>
 #include <cstring>
+#include <type_traits>
 
+#include <crillab-except/except.hpp>
 #include <crillab-universe/core/UniverseType.hpp>
 
 #include <crillab-panoramyx/network/MessageBuilder.hpp>
+#include <crillab-panoramyx/network/MessagePool.hpp>
 
 using namespace std;
 
+using namespace Except;
 using namespace Panoramyx;
 using namespace Universe;
 
+/**
+ * Writes a tagged big integer using the given message builder.
+ * This function is a template so that only the encodings matching the actual
+ * representation of big integers get compiled.
+ * Arbitrary precision values that fit in a machine integer use the same compact
+ * encoding as machine integers.
+ *
+ * @tparam B The type used to represent big integers.
+ *
+ * @param builder The builder to write the value with.
+ * @param value The value to write.
+ */
+template<typename B>
+static void writeBigInteger(MessageBuilder &builder, const B &value) {
+    if constexpr (is_integral_v<B>) {
+        // The value always fits in a machine integer.
+        builder.withParameter((char) PANO_BIG_INTEGER_SMALL).withInteger((long long) value);
+
+    } else if (value.fits_slong_p()) {
+        // The value fits in a machine integer, so that there is no need to format it.
+        builder.withParameter((char) PANO_BIG_INTEGER_SMALL).withInteger((long long) value.get_si());
+
+    } else {
+        // Large values are sent in their decimal representation.
+        builder.withParameter((char) PANO_BIG_INTEGER_DECIMAL).withString(Universe::toString(value));
+    }
+}
+
 MessageBuilder::MessageBuilder() :
-        size(sizeof(Message)) {
-    message = static_cast<Message *>(malloc(sizeof(Message)));
+        message(MessagePool::allocate(sizeof(Message))),
+        capacity(MessagePool::capacityOf(message)) {
+    message->version = PANO_PROTOCOL_VERSION;
+    message->opcode = MessageOpcode::NONE;
+    message->flags = 0;
     message->nbParameters = 0;
+    message->requestId = 0;
     message->size = 0;
 }
 
-MessageBuilder &MessageBuilder::named(const string &name) {
-    strncpy(message->name, name.c_str(), sizeof(message->name));
+MessageBuilder &MessageBuilder::reserve(unsigned long parametersSize) {
+    unsigned long needed = sizeof(Message) + message->size + parametersSize;
+    if (needed > capacity) {
+        message = MessagePool::reallocate(message, needed);
+        capacity = MessagePool::capacityOf(message);
+    }
+    return *this;
+}
+
+MessageBuilder &MessageBuilder::withOpcode(MessageOpcode opcode) {
+    message->opcode = opcode;
     return *this;
 }
 
@@ -62,20 +108,123 @@ MessageBuilder &MessageBuilder::withTag(int tag) {
     return *this;
 }
 
+MessageBuilder &MessageBuilder::withRequestId(unsigned int requestId) {
+    message->requestId = requestId;
+    return *this;
+}
+
+MessageBuilder &MessageBuilder::inResponseTo(const Message *request) {
+    message->tag = PANO_TAG_RESPONSE;
+    message->requestId = request->requestId;
+    return *this;
+}
+
+MessageBuilder &MessageBuilder::withFlags(unsigned char flags) {
+    message->flags |= flags;
+    return *this;
+}
+
 MessageBuilder &MessageBuilder::withParameter(string p) {
     message->nbParameters++;
-    size += p.size() + 1;
-    message = static_cast<Message *>(realloc(message, size));
-    memcpy(message->parameters + message->size, p.c_str(), p.size() + 1);
-    message->parameters[message->size + p.size()] = '\0';
-    message->size += p.size() + 1;
+    append(p.c_str(), p.size() + 1);
     return *this;
 }
 
 MessageBuilder &MessageBuilder::withParameter(BigInteger param) {
-    return this->withParameter(Universe::toString(param));
+    return this->withBigInteger(param);
+}
+
+MessageBuilder &MessageBuilder::withUnsigned(unsigned long long param) {
+    message->nbParameters++;
+    appendVarint(param);
+    return *this;
+}
+
+MessageBuilder &MessageBuilder::withInteger(long long param) {
+    message->nbParameters++;
+    appendVarint((((unsigned long long) param) << 1) ^ ((unsigned long long) (param >> 63)));
+    return *this;
+}
+
+MessageBuilder &MessageBuilder::withString(string_view param) {
+    message->nbParameters++;
+    appendVarint(param.size());
+    append(param.data(), param.size());
+    return *this;
+}
+
+MessageBuilder &MessageBuilder::withStream(istream &input, unsigned long length) {
+    message->nbParameters++;
+    appendVarint(length);
+    reserve(length);
+    if (!input.read(message->parameters + message->size, (streamsize) length)) {
+        throw IllegalStateException("could not read " + to_string(length) + " bytes from stream");
+    }
+    message->size += length;
+    return *this;
+}
+
+MessageBuilder &MessageBuilder::withMessage(const Message *param) {
+    message->nbParameters++;
+    unsigned long length = sizeof(Message) + param->size;
+    appendVarint(length);
+    append(param, length);
+    return *this;
+}
+
+MessageBuilder &MessageBuilder::withBigInteger(const BigInteger &param) {
+    writeBigInteger(*this, param);
+
+    // The tag and the value make a single parameter.
+    message->nbParameters--;
+    return *this;
+}
+
+MessageBuilder &MessageBuilder::withIndices(const vector<int> &param) {
+    vector<pair<int, unsigned long>> ranges;
+    for (auto index : param) {
+        if ((!ranges.empty()) && (index == ranges.back().first + (long long) ranges.back().second)) {
+            ranges.back().second++;
+        } else {
+            ranges.emplace_back(index, 1);
+        }
+    }
+
+    // Each range starts with its offset from the end of the previous one, which may be negative.
+    withUnsigned(ranges.size());
+    long long end = 0;
+    for (auto &[first, length] : ranges) {
+        withInteger(first - end).withUnsigned(length);
+        end = first + (long long) length;
+    }
+
+    // The ranges make a single parameter.
+    message->nbParameters -= (int) (2 * ranges.size());
+    return *this;
 }
 
 Message *MessageBuilder::build() {
     return message;
 }
+
+void MessageBuilder::append(const void *data, unsigned long length) {
+    unsigned long needed = sizeof(Message) + message->size + length;
+    if (needed > capacity) {
+        // The capacity is doubled to avoid reallocating on each parameter.
+        message = MessagePool::reallocate(message, max(needed, 2 * capacity));
+        capacity = MessagePool::capacityOf(message);
+    }
+    memcpy(message->parameters + message->size, data, length);
+    message->size += length;
+}
+
+void MessageBuilder::appendVarint(unsigned long long value) {
+    unsigned char bytes[10];
+    int n = 0;
+    while (value >= 0x80) {
+        bytes[n++] = (unsigned char) (value | 0x80);
+        value >>= 7;
+    }
+    bytes[n++] = (unsigned char) value;
+    append(bytes, n);
+}
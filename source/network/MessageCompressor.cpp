@@ -0,0 +1,336 @@
+/**
+ * PANORAMYX - Programming pArallel coNstraint sOlveRs mAde aMazingly easY.
+ * Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see {@link http://www.gnu.org/licenses}.
+ */
+
+/**
+ * @file MessageCompressor.cpp
+ * @brief Provides a fast LZ77 codec for the parameters of messages.
+ *
+ * @author Thibault Falque
+ * @author Romain Wallon
+ *
+ * @copyright Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include <crillab-except/except.hpp>
+
+#include <crillab-panoramyx/network/MessageCompressor.hpp>
+#include <crillab-panoramyx/network/MessagePool.hpp>
+
+/**
+ * The minimum length of a back-reference.
+ */
+#define PANO_COMPRESSION_MIN_MATCH 4
+
+/**
+ * The number of bytes at the end of the input that are always encoded as literals.
+ */
+#define PANO_COMPRESSION_LAST_LITERALS 5
+
+/**
+ * The binary logarithm of the number of failed attempts to find a match after
+ * which the compressor starts skipping bytes (to quickly get through incompressible data).
+ */
+#define PANO_COMPRESSION_SKIP_LOG 6
+
+using namespace std;
+
+using namespace Except;
+using namespace Panoramyx;
+
+/**
+ * Reads four bytes from the given input.
+ *
+ * @param input The input to read from.
+ *
+ * @return The read bytes.
+ */
+static unsigned read32(const unsigned char *input) {
+    unsigned value;
+    memcpy(&value, input, sizeof(value));
+    return value;
+}
+
+/**
+ * Computes the index of a sequence of four bytes in the hash table of the compressor.
+ *
+ * @param sequence The sequence to hash.
+ *
+ * @return The index of the sequence.
+ */
+static unsigned hashOf(unsigned sequence) {
+    return (sequence * 2654435761U) >> (32 - PANO_COMPRESSION_HASH_LOG);
+}
+
+/**
+ * Writes the extension of a length that does not fit in a token.
+ *
+ * @param output The output to write to, which is moved past the written bytes.
+ * @param limit The end of the output.
+ * @param length The length to write.
+ *
+ * @return Whether the length fits in the output.
+ */
+static bool writeLength(unsigned char *&output, const unsigned char *limit, unsigned long length) {
+    for (; length >= 255; length -= 255) {
+        if (output >= limit) {
+            return false;
+        }
+        *output++ = 255;
+    }
+    if (output >= limit) {
+        return false;
+    }
+    *output++ = (unsigned char) length;
+    return true;
+}
+
+/**
+ * Reads the extension of a length that does not fit in a token.
+ *
+ * @param input The input to read from, which is moved past the read bytes.
+ * @param end The end of the input.
+ *
+ * @return The read length.
+ */
+static unsigned long readLength(const unsigned char *&input, const unsigned char *end) {
+    unsigned long length = 0;
+    for (;;) {
+        if (input >= end) {
+            throw IllegalStateException("truncated compressed message");
+        }
+        unsigned char byte = *input++;
+        length += byte;
+        if (byte != 255) {
+            return length;
+        }
+    }
+}
+
+/**
+ * Writes a sequence made of literals followed by a back-reference.
+ *
+ * @param output The output to write to, which is moved past the written bytes.
+ * @param limit The end of the output.
+ * @param literals The literal bytes of the sequence.
+ * @param nbLiterals The number of literal bytes.
+ * @param offset The distance between the current position and the referenced bytes.
+ * @param matchLength The number of referenced bytes, or 0 for the last sequence,
+ *        which is only made of literals.
+ *
+ * @return Whether the sequence fits in the output.
+ */
+static bool writeSequence(unsigned char *&output, const unsigned char *limit, const unsigned char *literals,
+                          unsigned long nbLiterals, unsigned long offset, unsigned long matchLength) {
+    if (output >= limit) {
+        return false;
+    }
+    unsigned char *token = output++;
+    *token = (unsigned char) (min(nbLiterals, 15UL) << 4);
+    if ((nbLiterals >= 15) && !writeLength(output, limit, nbLiterals - 15)) {
+        return false;
+    }
+    if ((unsigned long) (limit - output) < nbLiterals) {
+        return false;
+    }
+    memcpy(output, literals, nbLiterals);
+    output += nbLiterals;
+
+    if (matchLength == 0) {
+        // This is the last sequence.
+        return true;
+    }
+
+    if (limit - output < 2) {
+        return false;
+    }
+    *output++ = (unsigned char) (offset & 0xff);
+    *output++ = (unsigned char) (offset >> 8);
+    unsigned long extra = matchLength - PANO_COMPRESSION_MIN_MATCH;
+    *token |= (unsigned char) min(extra, 15UL);
+    return (extra < 15) || writeLength(output, limit, extra - 15);
+}
+
+/**
+ * Compresses a block of bytes.
+ *
+ * @param input The bytes to compress.
+ * @param size The number of bytes to compress.
+ * @param output The output in which to write the compressed bytes.
+ * @param capacity The capacity of the output.
+ *
+ * @return The number of compressed bytes, or 0 if they do not fit in the output.
+ */
+static unsigned long compressBlock(const unsigned char *input, unsigned long size,
+                                   unsigned char *output, unsigned long capacity) {
+    // The table stores the position (plus one) of the last occurrence of each hash.
+    vector<unsigned long> table(1UL << PANO_COMPRESSION_HASH_LOG, 0);
+    unsigned char *out = output;
+    const unsigned char *limit = output + capacity;
+    const unsigned char *end = input + size;
+    const unsigned char *anchor = input;
+    const unsigned char *current = input;
+
+    if (size > PANO_COMPRESSION_LAST_LITERALS + PANO_COMPRESSION_MIN_MATCH) {
+        const unsigned char *matchLimit = end - PANO_COMPRESSION_LAST_LITERALS;
+        while (current + PANO_COMPRESSION_MIN_MATCH <= matchLimit) {
+            unsigned sequence = read32(current);
+            unsigned long position = current - input;
+            unsigned long candidate = table[hashOf(sequence)];
+            table[hashOf(sequence)] = position + 1;
+
+            if ((candidate == 0) || (position + 1 - candidate > PANO_COMPRESSION_WINDOW_SIZE)
+                || (read32(input + candidate - 1) != sequence)) {
+                current += 1 + ((current - anchor) >> PANO_COMPRESSION_SKIP_LOG);
+                continue;
+            }
+
+            const unsigned char *match = input + candidate - 1;
+            unsigned long length = PANO_COMPRESSION_MIN_MATCH;
+            while ((current + length < matchLimit) && (current[length] == match[length])) {
+                length++;
+            }
+            if (!writeSequence(out, limit, anchor, current - anchor, current - match, length)) {
+                return 0;
+            }
+            current += length;
+            anchor = current;
+        }
+    }
+
+    if (!writeSequence(out, limit, anchor, end - anchor, 0, 0)) {
+        return 0;
+    }
+    return out - output;
+}
+
+/**
+ * Decompresses a block of bytes.
+ *
+ * @param input The bytes to decompress.
+ * @param size The number of bytes to decompress.
+ * @param output The output in which to write the decompressed bytes.
+ * @param expectedSize The number of bytes expected after decompression.
+ *
+ * @throws IllegalStateException If the input is not a valid compressed block.
+ */
+static void decompressBlock(const unsigned char *input, unsigned long size,
+                            unsigned char *output, unsigned long expectedSize) {
+    const unsigned char *end = input + size;
+    unsigned char *out = output;
+    const unsigned char *limit = output + expectedSize;
+
+    while (input < end) {
+        unsigned char token = *input++;
+        unsigned long nbLiterals = token >> 4;
+        if (nbLiterals == 15) {
+            nbLiterals += readLength(input, end);
+        }
+        if (((unsigned long) (end - input) < nbLiterals) || ((unsigned long) (limit - out) < nbLiterals)) {
+            throw IllegalStateException("corrupted compressed message");
+        }
+        memcpy(out, input, nbLiterals);
+        out += nbLiterals;
+        input += nbLiterals;
+
+        if (input == end) {
+            // This was the last sequence.
+            break;
+        }
+
+        if (end - input < 2) {
+            throw IllegalStateException("truncated compressed message");
+        }
+        unsigned long offset = input[0] | (input[1] << 8);
+        input += 2;
+        unsigned long length = (token & 15) + PANO_COMPRESSION_MIN_MATCH;
+        if ((token & 15) == 15) {
+            length += readLength(input, end);
+        }
+        if ((offset == 0) || (offset > (unsigned long) (out - output)) || ((unsigned long) (limit - out) < length)) {
+            throw IllegalStateException("corrupted compressed message");
+        }
+
+        // The referenced bytes may overlap with the copied ones.
+        const unsigned char *match = out - offset;
+        for (unsigned long i = 0; i < length; i++) {
+            out[i] = match[i];
+        }
+        out += length;
+    }
+
+    if (out != limit) {
+        throw IllegalStateException("corrupted compressed message");
+    }
+}
+
+Message *MessageCompressor::compress(const Message *message) {
+    unsigned long size = message->size;
+    if (size <= sizeof(size)) {
+        return nullptr;
+    }
+
+    auto *compressed = MessagePool::allocate(sizeof(Message) + size);
+    memcpy(compressed, message, sizeof(Message));
+    memcpy(compressed->parameters, &size, sizeof(size));
+
+    // The compressed parameters must be strictly smaller than the original ones.
+    unsigned long nbBytes = compressBlock((const unsigned char *) message->parameters, size,
+                                          (unsigned char *) compressed->parameters + sizeof(size),
+                                          size - sizeof(size) - 1);
+    if (nbBytes == 0) {
+        MessagePool::release(compressed);
+        return nullptr;
+    }
+
+    compressed->size = sizeof(size) + nbBytes;
+    compressed->flags |= PANO_FLAG_COMPRESSED;
+    return compressed;
+}
+
+Message *MessageCompressor::decompress(const Message *message) {
+    unsigned long size;
+    if (message->size < sizeof(size)) {
+        throw IllegalStateException("truncated compressed message");
+    }
+    memcpy(&size, message->parameters, sizeof(size));
+
+    auto *decompressed = MessagePool::allocate(sizeof(Message) + size);
+    memcpy(decompressed, message, sizeof(Message));
+    decompressed->size = size;
+    decompressed->flags &= ~PANO_FLAG_COMPRESSED;
+
+    try {
+        decompressBlock((const unsigned char *) message->parameters + sizeof(size), message->size - sizeof(size),
+                        (unsigned char *) decompressed->parameters, size);
+    } catch (...) {
+        MessagePool::release(decompressed);
+        throw;
+    }
+    return decompressed;
+}
+
+bool MessageCompressor::isCompressed(const Message *message) {
+    return (message->flags & PANO_FLAG_COMPRESSED) != 0;
+}
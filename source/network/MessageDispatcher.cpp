@@ -0,0 +1,47 @@
+/**
+ * PANORAMYX - Programming pArallel coNstraint sOlveRs mAde aMazingly easY.
+ * Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see {@link http://www.gnu.org/licenses}.
+ */
+
+/**
+ * @file MessageDispatcher.cpp
+ * @brief Provides a table associating each opcode with the function handling the corresponding messages.
+ *
+ * @author Thibault Falque
+ * @author Romain Wallon
+ *
+ * @copyright Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#include <loguru.hpp>
+
+#include <crillab-panoramyx/network/MessageDispatcher.hpp>
+
+using namespace Panoramyx;
+
+void Panoramyx::reportUndispatchedMessage(const char *owner, const Message *message) {
+    if (message->version != PANO_PROTOCOL_VERSION) {
+        LOG_F(WARNING, "%s: ignoring message from %d built with protocol version %d (expected %d)",
+              owner, message->src, (int) message->version, PANO_PROTOCOL_VERSION);
+        return;
+    }
+
+    LOG_F(WARNING, "%s: ignoring message '%s' (opcode %d) from %d: no handler for this opcode",
+          owner, nameOf(message->opcode), (int) message->opcode, message->src);
+}
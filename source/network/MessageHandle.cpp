@@ -0,0 +1,75 @@
+/**
+ * PANORAMYX - Programming pArallel coNstraint sOlveRs mAde aMazingly easY.
+ * Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see {@link http://www.gnu.org/licenses}.
+ */
+
+/**
+ * @file MessageHandle.cpp
+ * @brief Owns a message allocated by the message pool.
+ *
+ * @author Thibault Falque
+ * @author Romain Wallon
+ *
+ * @copyright Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#include <crillab-panoramyx/network/MessageHandle.hpp>
+#include <crillab-panoramyx/network/MessagePool.hpp>
+
+using namespace Panoramyx;
+
+MessageHandle::MessageHandle(Message *message) :
+        message(message) {
+    // Nothing to do: everything is already initialized.
+}
+
+MessageHandle::MessageHandle(MessageHandle &&other) noexcept:
+        message(other.release()) {
+    // Nothing to do: everything is already initialized.
+}
+
+MessageHandle &MessageHandle::operator=(MessageHandle &&other) noexcept {
+    reset(other.release());
+    return *this;
+}
+
+MessageHandle::~MessageHandle() {
+    MessagePool::release(message);
+}
+
+Message *MessageHandle::get() const {
+    return message;
+}
+
+Message *MessageHandle::operator->() const {
+    return message;
+}
+
+Message *MessageHandle::release() {
+    Message *released = message;
+    message = nullptr;
+    return released;
+}
+
+void MessageHandle::reset(Message *other) {
+    if (message != other) {
+        MessagePool::release(message);
+        message = other;
+    }
+}
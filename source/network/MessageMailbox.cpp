@@ -0,0 +1,127 @@
+/**
+ * PANORAMYX - Programming pArallel coNstraint sOlveRs mAde aMazingly easY.
+ * Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see {@link http://www.gnu.org/licenses}.
+ */
+
+/**
+ * @file MessageMailbox.cpp
+ * @brief A mailbox in which messages are delivered to a communicator sharing the address space of their senders.
+ *
+ * @author Thibault Falque
+ * @author Romain Wallon
+ *
+ * @copyright Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#include <crillab-panoramyx/network/MessageMailbox.hpp>
+#include <crillab-panoramyx/network/MessagePool.hpp>
+
+using namespace std;
+
+using namespace Panoramyx;
+
+/**
+ * Checks whether a message matches the given tag and source.
+ *
+ * @param message The message to check.
+ * @param tag The expected tag (may be PANO_ANY_TAG).
+ * @param src The expected source (may be PANO_ANY_SOURCE).
+ *
+ * @return Whether the message matches.
+ */
+static bool matches(const Message *message, int tag, int src) {
+    return ((tag == PANO_ANY_TAG) || (message->tag == tag))
+           && ((src == PANO_ANY_SOURCE) || (message->src == src));
+}
+
+MessageMailbox::MessageMailbox() :
+        head(nullptr),
+        sequence(0) {
+    // Nothing to do: everything is already initialized.
+}
+
+MessageMailbox::~MessageMailbox() {
+    drain();
+    for (auto *message : pending) {
+        MessagePool::release(message);
+    }
+}
+
+void MessageMailbox::deliver(Message *message) {
+    auto *node = new Node {message, head.load(memory_order_relaxed)};
+    while (!head.compare_exchange_weak(node->next, node, memory_order_release, memory_order_relaxed)) {
+        // The head has been updated in node->next, so we only need to try again.
+    }
+
+    sequence.fetch_add(1, memory_order_release);
+    sequence.notify_all();
+}
+
+void MessageMailbox::drain() {
+    auto *node = head.exchange(nullptr, memory_order_acquire);
+
+    // The stack gives the most recent message first, so it is reversed.
+    Node *reversed = nullptr;
+    while (node != nullptr) {
+        auto *next = node->next;
+        node->next = reversed;
+        reversed = node;
+        node = next;
+    }
+
+    while (reversed != nullptr) {
+        pending.push_back(reversed->message);
+        auto *next = reversed->next;
+        delete reversed;
+        reversed = next;
+    }
+}
+
+Message *MessageMailbox::match(int tag, int src) {
+    for (auto it = pending.begin(); it != pending.end(); ++it) {
+        if (matches(*it, tag, src)) {
+            auto *message = *it;
+            pending.erase(it);
+            return message;
+        }
+    }
+    return nullptr;
+}
+
+Message *MessageMailbox::receive(int tag, int src) {
+    for (;;) {
+        // Reading the sequence before draining ensures that no delivery is missed.
+        auto seen = sequence.load(memory_order_acquire);
+        {
+            scoped_lock lock(receiverMutex);
+            drain();
+            auto *message = match(tag, src);
+            if (message != nullptr) {
+                return message;
+            }
+        }
+        sequence.wait(seen, memory_order_acquire);
+    }
+}
+
+Message *MessageMailbox::tryReceive(int tag, int src) {
+    scoped_lock lock(receiverMutex);
+    drain();
+    return match(tag, src);
+}
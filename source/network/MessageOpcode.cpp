@@ -0,0 +1,51 @@
+/**
+ * PANORAMYX - Programming pArallel coNstraint sOlveRs mAde aMazingly easY.
+ * Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see {@link http://www.gnu.org/licenses}.
+ */
+
+/**
+ * @file MessageOpcode.cpp
+ * @brief Defines the operation codes identifying the messages exchanged by the solvers.
+ *
+ * @author Thibault Falque
+ * @author Romain Wallon
+ *
+ * @copyright Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#include <crillab-panoramyx/network/MessageOpcode.hpp>
+
+using namespace Panoramyx;
+
+/**
+ * The names of the opcodes, indexed by opcode.
+ */
+static const char *const NAMES[] = {
+        "none",
+#define PANO_NAME_OPCODE(opcode, name) name,
+        PANO_MESSAGE_OPCODES(PANO_NAME_OPCODE)
+#undef PANO_NAME_OPCODE
+};
+
+const char *Panoramyx::nameOf(MessageOpcode opcode) {
+    if (opcode >= MessageOpcode::NB_OPCODES) {
+        return "???";
+    }
+    return NAMES[(unsigned) opcode];
+}
@@ -0,0 +1,179 @@
+/**
+ * PANORAMYX - Programming pArallel coNstraint sOlveRs mAde aMazingly easY.
+ * Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see {@link http://www.gnu.org/licenses}.
+ */
+
+/**
+ * @file MessagePool.cpp
+ * @brief Provides pooled memory for the messages sent through the network.
+ *
+ * @author Thibault Falque
+ * @author Romain Wallon
+ *
+ * @copyright Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <vector>
+
+#include <crillab-panoramyx/network/MessagePool.hpp>
+
+using namespace std;
+
+using namespace Panoramyx;
+
+/**
+ * The number of size classes for which buffers are pooled.
+ */
+#define NB_SIZE_CLASSES (PANO_POOL_LARGEST_SIZE_CLASS - PANO_POOL_SMALLEST_SIZE_CLASS + 1)
+
+/**
+ * The BufferHeader is stored right before each message allocated by the pool,
+ * to remember where the buffer must go back when the message is released.
+ */
+struct alignas(max_align_t) BufferHeader {
+
+    /**
+     * The number of bytes that can be stored in the message.
+     */
+    unsigned long capacity;
+
+    /**
+     * The index of the size class of the buffer, or -1 if the buffer is not pooled.
+     */
+    int sizeClass;
+
+};
+
+/**
+ * The FreeLists are the buffers that have been released by a given thread and
+ * that are ready to be reused.
+ */
+struct FreeLists {
+
+    /**
+     * The free buffers, indexed by size class.
+     */
+    vector<BufferHeader *> buffers[NB_SIZE_CLASSES];
+
+    /**
+     * Destroys these FreeLists, giving the buffers back to the system.
+     */
+    ~FreeLists() {
+        for (auto &list: buffers) {
+            for (auto *buffer: list) {
+                std::free(buffer);
+            }
+        }
+    }
+
+};
+
+/**
+ * The free buffers of the current thread.
+ */
+static thread_local FreeLists freeLists;
+
+/**
+ * Gives the header of a message allocated by the pool.
+ *
+ * @param message The message to get the header of.
+ *
+ * @return The header of the message.
+ */
+static BufferHeader *headerOf(const Message *message) {
+    return ((BufferHeader *) message) - 1;
+}
+
+/**
+ * Gives the index of the smallest size class able to store the given number of bytes.
+ *
+ * @param size The number of bytes to store.
+ *
+ * @return The index of the size class, or -1 if the buffer is too big to be pooled.
+ */
+static int sizeClassOf(unsigned long size) {
+    for (int i = 0; i < NB_SIZE_CLASSES; i++) {
+        if (size <= (1UL << (i + PANO_POOL_SMALLEST_SIZE_CLASS))) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+Message *MessagePool::allocate(unsigned long size) {
+    int sizeClass = sizeClassOf(size);
+    BufferHeader *header;
+
+    if ((sizeClass >= 0) && !freeLists.buffers[sizeClass].empty()) {
+        // A buffer of the right size class can be reused.
+        header = freeLists.buffers[sizeClass].back();
+        freeLists.buffers[sizeClass].pop_back();
+        return (Message *) (header + 1);
+    }
+
+    // A new buffer must be allocated.
+    unsigned long capacity = (sizeClass < 0) ? size : (1UL << (sizeClass + PANO_POOL_SMALLEST_SIZE_CLASS));
+    header = static_cast<BufferHeader *>(std::malloc(sizeof(BufferHeader) + capacity));
+    if (header == nullptr) {
+        throw bad_alloc();
+    }
+    header->capacity = capacity;
+    header->sizeClass = sizeClass;
+    return (Message *) (header + 1);
+}
+
+Message *MessagePool::reallocate(Message *message, unsigned long size) {
+    if (message == nullptr) {
+        return allocate(size);
+    }
+
+    unsigned long capacity = capacityOf(message);
+    if (size <= capacity) {
+        // The message is already big enough.
+        return message;
+    }
+
+    Message *resized = allocate(size);
+    memcpy(resized, message, capacity);
+    release(message);
+    return resized;
+}
+
+void MessagePool::release(Message *message) {
+    if (message == nullptr) {
+        return;
+    }
+
+    auto *header = headerOf(message);
+    if ((header->sizeClass >= 0) && (freeLists.buffers[header->sizeClass].size() < PANO_POOL_MAX_FREE_BUFFERS)) {
+        // The buffer is kept for later use by this thread.
+        freeLists.buffers[header->sizeClass].push_back(header);
+        return;
+    }
+
+    std::free(header);
+}
+
+unsigned long MessagePool::capacityOf(const Message *message) {
+    return headerOf(message)->capacity;
+}
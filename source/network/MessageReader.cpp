@@ -0,0 +1,158 @@
+/**
+ * PANORAMYX - Programming pArallel coNstraint sOlveRs mAde aMazingly easY.
+ * Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see {@link http://www.gnu.org/licenses}.
+ */
+
+/**
+ * @file MessageReader.cpp
+ * @brief Reads the parameters of messages received through the network.
+ *
+ * @author Thibault Falque
+ * @author Romain Wallon
+ *
+ * @copyright Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#include <climits>
+#include <limits>
+#include <string>
+#include <type_traits>
+
+#include <crillab-except/except.hpp>
+
+#include <crillab-panoramyx/network/MessagePool.hpp>
+#include <crillab-panoramyx/network/MessageReader.hpp>
+
+using namespace std;
+
+using namespace Except;
+using namespace Panoramyx;
+using namespace Universe;
+
+/**
+ * Converts a machine integer read from a message into a big integer.
+ * This function is a template so that only the conversion matching the actual
+ * representation of big integers gets compiled.
+ *
+ * @tparam B The type used to represent big integers.
+ *
+ * @param value The value to convert.
+ *
+ * @return The converted value.
+ */
+template<typename B>
+static B toBigInteger(long long value) {
+    if constexpr (is_integral_v<B>) {
+        return (B) value;
+
+    } else if ((numeric_limits<long>::min() <= value) && (value <= numeric_limits<long>::max())) {
+        // Arbitrary precision values are built directly from the values that fit in a long.
+        return B((long) value);
+
+    } else {
+        return bigIntegerValueOf(to_string(value));
+    }
+}
+
+MessageReader::MessageReader(const Message *message, unsigned long offset) :
+        message(message),
+        offset(offset) {
+    // Nothing to do: everything is already initialized.
+}
+
+unsigned long long MessageReader::readUnsigned() {
+    unsigned long long value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        auto byte = read<unsigned char>();
+        value |= ((unsigned long long) (byte & 0x7f)) << shift;
+        if ((byte & 0x80) == 0) {
+            return value;
+        }
+    }
+    throw IllegalStateException("malformed varint in message");
+}
+
+long long MessageReader::readInteger() {
+    auto value = readUnsigned();
+    return (long long) (value >> 1) ^ -((long long) (value & 1));
+}
+
+string_view MessageReader::readString() {
+    auto length = (unsigned long) readUnsigned();
+    ensureRemaining(length);
+    string_view value(message->parameters + offset, length);
+    offset += length;
+    return value;
+}
+
+BigInteger MessageReader::readBigInteger() {
+    auto tag = read<char>();
+    if (tag == PANO_BIG_INTEGER_SMALL) {
+        return toBigInteger<BigInteger>(readInteger());
+    }
+    if (tag == PANO_BIG_INTEGER_DECIMAL) {
+        return bigIntegerValueOf(string(readString()));
+    }
+    throw IllegalStateException("unknown big integer encoding in message");
+}
+
+Message *MessageReader::readMessage() {
+    auto length = (unsigned long) readUnsigned();
+    ensureRemaining(length);
+    if (length < sizeof(Message)) {
+        throw IllegalStateException("embedded message is too short");
+    }
+
+    auto *embedded = MessagePool::allocate(length);
+    memcpy(embedded, message->parameters + offset, length);
+    offset += length;
+    return embedded;
+}
+
+vector<int> MessageReader::readIndices() {
+    vector<int> indices;
+    auto nbRanges = readUnsigned();
+    long long end = 0;
+    for (unsigned long long i = 0; i < nbRanges; i++) {
+        long long first = end + readInteger();
+        auto length = (long long) readUnsigned();
+        if ((first < INT_MIN) || (first + length - 1 > INT_MAX)) {
+            throw IllegalStateException("index out of range");
+        }
+        for (long long index = first; index < first + length; index++) {
+            indices.push_back((int) index);
+        }
+        end = first + length;
+    }
+    return indices;
+}
+
+bool MessageReader::hasRemaining() const {
+    return offset < message->size;
+}
+
+unsigned long MessageReader::getOffset() const {
+    return offset;
+}
+
+void MessageReader::ensureRemaining(unsigned long length) const {
+    if (offset + length > message->size) {
+        throw IllegalStateException("trying to read past the end of a message");
+    }
+}
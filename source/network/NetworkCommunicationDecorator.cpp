@@ -0,0 +1,93 @@
+/**
+ * PANORAMYX - Programming pArallel coNstraint sOlveRs mAde aMazingly easY.
+ * Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see {@link http://www.gnu.org/licenses}.
+ */
+
+/**
+ * @file NetworkCommunicationDecorator.cpp
+ * @brief Provides a base class for the communications adding a behavior to another communication.
+ *
+ * @author Thibault Falque
+ * @author Romain Wallon
+ *
+ * @copyright Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#include <crillab-panoramyx/network/NetworkCommunicationDecorator.hpp>
+
+using namespace std;
+
+using namespace Panoramyx;
+
+NetworkCommunicationDecorator::NetworkCommunicationDecorator(INetworkCommunication *decorated) :
+        decorated(decorated) {
+    // Nothing to do: everything is already initialized.
+}
+
+int NetworkCommunicationDecorator::getId() {
+    return decorated->getId();
+}
+
+int NetworkCommunicationDecorator::nbProcesses() {
+    return decorated->nbProcesses();
+}
+
+void NetworkCommunicationDecorator::start(function<void()> runnable) {
+    decorated->start(move(runnable));
+}
+
+function<void()> NetworkCommunicationDecorator::attach(function<void()> runnable) {
+    return decorated->attach(move(runnable));
+}
+
+Message *NetworkCommunicationDecorator::receive(int tag, int src) {
+    return decorated->receive(tag, src);
+}
+
+void NetworkCommunicationDecorator::send(Message *message, int dest) {
+    decorated->send(message, dest);
+}
+
+void NetworkCommunicationDecorator::transfer(Message *message, int dest) {
+    decorated->transfer(message, dest);
+}
+
+INetworkRequest *NetworkCommunicationDecorator::irecv(int tag, int src) {
+    return decorated->irecv(tag, src);
+}
+
+INetworkRequest *NetworkCommunicationDecorator::isend(Message *message, int dest) {
+    return decorated->isend(message, dest);
+}
+
+void NetworkCommunicationDecorator::broadcast(Message *message, const vector<int> &ranks) {
+    decorated->broadcast(message, ranks);
+}
+
+void NetworkCommunicationDecorator::waitAll(const vector<INetworkRequest *> &requests) {
+    decorated->waitAll(requests);
+}
+
+int NetworkCommunicationDecorator::testAny(const vector<INetworkRequest *> &requests) {
+    return decorated->testAny(requests);
+}
+
+void NetworkCommunicationDecorator::finalize() {
+    decorated->finalize();
+}
@@ -31,8 +31,12 @@
 
 #include <mpi.h>
 
+#include <crillab-panoramyx/network/CompressedNetworkCommunication.hpp>
+#include <crillab-panoramyx/network/HybridCommunication.hpp>
+#include <crillab-panoramyx/network/InstrumentedNetworkCommunication.hpp>
 #include <crillab-panoramyx/network/NetworkCommunicationFactory.hpp>
 #include <crillab-panoramyx/network/MPINetworkCommunication.hpp>
+#include <crillab-panoramyx/network/SharedMemoryCommunication.hpp>
 #include <crillab-panoramyx/network/ThreadCommunication.hpp>
 
 using namespace Panoramyx;
@@ -43,12 +47,34 @@ NetworkCommunicationFactory::NetworkCommunicationFactory(int *argc, char ***argv
     // Nothing to do: everything is already initialized.
 }
 
-INetworkCommunication *NetworkCommunicationFactory::createMPINetworkCommunication() {
+INetworkCommunication *NetworkCommunicationFactory::createMPINetworkCommunication(unsigned long chunkSize) {
     int provided = 0;
     MPI_Init_thread(argc, argv, MPI_THREAD_MULTIPLE, &provided);
-    return MPINetworkCommunication::getInstance();
+    return MPINetworkCommunication::getInstance(chunkSize);
 }
 
 INetworkCommunication *NetworkCommunicationFactory::createThreadCommunication(int nbThreads) {
     return new ThreadCommunication(nbThreads);
 }
+
+INetworkCommunication *NetworkCommunicationFactory::createHybridCommunication(int nbThreads,
+                                                                             unsigned long chunkSize) {
+    int provided = 0;
+    MPI_Init_thread(argc, argv, MPI_THREAD_MULTIPLE, &provided);
+    return new HybridCommunication(nbThreads, chunkSize);
+}
+
+INetworkCommunication *NetworkCommunicationFactory::createSharedMemoryCommunication(int nbProcesses,
+                                                                                   unsigned long ringSize) {
+    return SharedMemoryCommunication::create(nbProcesses, ringSize);
+}
+
+INetworkCommunication *NetworkCommunicationFactory::createInstrumentedCommunication(INetworkCommunication *communication,
+                                                                                   const std::string &reportFile) {
+    return new InstrumentedNetworkCommunication(communication, reportFile);
+}
+
+INetworkCommunication *NetworkCommunicationFactory::createCompressedCommunication(INetworkCommunication *communication,
+                                                                                 unsigned long threshold) {
+    return new CompressedNetworkCommunication(communication, threshold);
+}
@@ -0,0 +1,89 @@
+/**
+ * PANORAMYX - Programming pArallel coNstraint sOlveRs mAde aMazingly easY.
+ * Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see {@link http://www.gnu.org/licenses}.
+ */
+
+/**
+ * @file ResponseDispatcher.cpp
+ * @brief Matches the responses sent by a remote communicator with the requests they answer.
+ *
+ * @author Thibault Falque
+ * @author Romain Wallon
+ *
+ * @copyright Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#include <crillab-panoramyx/network/MessagePool.hpp>
+#include <crillab-panoramyx/network/ResponseDispatcher.hpp>
+
+using namespace std;
+using namespace Panoramyx;
+
+ResponseDispatcher::ResponseDispatcher(int rank) :
+        communicator(nullptr),
+        rank(rank),
+        lastRequestId(0),
+        receiving(false) {
+    // Nothing to do: everything is already initialized.
+}
+
+ResponseDispatcher::~ResponseDispatcher() {
+    for (auto &[requestId, response] : responses) {
+        MessagePool::release(response);
+    }
+}
+
+void ResponseDispatcher::setCommunicator(INetworkCommunication *communicator) {
+    this->communicator = communicator;
+}
+
+unsigned int ResponseDispatcher::newRequestId() {
+    unsigned int requestId;
+    do {
+        // The identifier 0 is reserved for the messages that are not requests.
+        requestId = ++lastRequestId;
+    } while (requestId == 0);
+    return requestId;
+}
+
+Message *ResponseDispatcher::await(unsigned int requestId) {
+    unique_lock lock(responsesMutex);
+    for (;;) {
+        auto it = responses.find(requestId);
+        if (it != responses.end()) {
+            Message *response = it->second;
+            responses.erase(it);
+            return response;
+        }
+
+        if (receiving) {
+            // Another thread is receiving the responses on our behalf.
+            received.wait(lock);
+            continue;
+        }
+
+        receiving = true;
+        lock.unlock();
+        Message *response = communicator->receive(PANO_TAG_RESPONSE, rank);
+        lock.lock();
+        receiving = false;
+        responses[response->requestId] = response;
+        received.notify_all();
+    }
+}
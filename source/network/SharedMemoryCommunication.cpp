@@ -0,0 +1,433 @@
+/**
+ * PANORAMYX - Programming pArallel coNstraint sOlveRs mAde aMazingly easY.
+ * Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see {@link http://www.gnu.org/licenses}.
+ */
+
+/**
+ * @file SharedMemoryCommunication.cpp
+ * @brief An implementation of INetworkCommunication based on POSIX shared memory.
+ *
+ * @author Thibault Falque
+ * @author Romain Wallon
+ *
+ * @copyright Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <csignal>
+#include <cstdint>
+#include <string>
+
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/prctl.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <crillab-except/except.hpp>
+
+#include <crillab-panoramyx/network/CompletedNetworkRequest.hpp>
+#include <crillab-panoramyx/network/MessagePool.hpp>
+#include <crillab-panoramyx/network/SharedMemoryCommunication.hpp>
+#include <crillab-panoramyx/network/SharedMemoryReceiveRequest.hpp>
+
+using namespace std;
+
+using namespace Except;
+using namespace Panoramyx;
+
+/**
+ * The size of a cache line, used to avoid false sharing between processes.
+ */
+#define PANO_CACHE_LINE_SIZE 64
+
+namespace {
+
+    /**
+     * The Doorbell is rung to wake up the threads of a process that wait for a message.
+     */
+    struct alignas(PANO_CACHE_LINE_SIZE) Doorbell {
+
+        /**
+         * The number of times the doorbell has been rung (used as a futex).
+         */
+        atomic<uint32_t> value;
+
+        /**
+         * The number of threads waiting on this doorbell.
+         */
+        atomic<uint32_t> waiters;
+
+    };
+
+    /**
+     * The Ring is the header of a ring buffer, whose bytes immediately follow it.
+     */
+    struct alignas(PANO_CACHE_LINE_SIZE) Ring {
+
+        /**
+         * The total number of bytes written to the ring (only updated by the producer).
+         */
+        alignas(PANO_CACHE_LINE_SIZE) atomic<uint64_t> head;
+
+        /**
+         * The total number of bytes read from the ring (only updated by the consumer).
+         */
+        alignas(PANO_CACHE_LINE_SIZE) atomic<uint64_t> tail;
+
+        /**
+         * The number of times the consumer has made space in the ring (used as a futex).
+         */
+        alignas(PANO_CACHE_LINE_SIZE) atomic<uint32_t> space;
+
+        /**
+         * The number of threads waiting for space in the ring.
+         */
+        atomic<uint32_t> waiters;
+
+        /**
+         * Gives the bytes stored in this ring.
+         *
+         * @return The bytes of the ring.
+         */
+        char *data() {
+            return reinterpret_cast<char *>(this + 1);
+        }
+
+    };
+
+    static_assert(atomic<uint32_t>::is_always_lock_free && atomic<uint64_t>::is_always_lock_free,
+                  "atomics in shared memory must be lock-free");
+
+    /**
+     * Waits on a futex shared between processes, as long as it has the expected value.
+     *
+     * @param futex The futex to wait on.
+     * @param expected The expected value of the futex.
+     */
+    void futexWait(atomic<uint32_t> *futex, uint32_t expected) {
+        syscall(SYS_futex, reinterpret_cast<uint32_t *>(futex), FUTEX_WAIT, expected, nullptr, nullptr, 0);
+    }
+
+    /**
+     * Wakes up all the threads waiting on a futex shared between processes.
+     *
+     * @param futex The futex to wake up the waiters of.
+     */
+    void futexWake(atomic<uint32_t> *futex) {
+        syscall(SYS_futex, reinterpret_cast<uint32_t *>(futex), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+    }
+
+    /**
+     * Gives the number of bytes occupied by a ring in the segment.
+     *
+     * @param ringSize The capacity (in bytes) of the ring.
+     *
+     * @return The size of the ring, including its header.
+     */
+    unsigned long strideOf(unsigned long ringSize) {
+        return sizeof(Ring) + ringSize;
+    }
+
+    /**
+     * Gives the doorbell of a process.
+     *
+     * @param segment The shared memory segment.
+     * @param process The identifier of the process.
+     *
+     * @return The doorbell of the process.
+     */
+    Doorbell *doorbellOf(char *segment, int process) {
+        return reinterpret_cast<Doorbell *>(segment) + process;
+    }
+
+    /**
+     * Gives the ring going from a process to another.
+     *
+     * @param segment The shared memory segment.
+     * @param nbProcs The number of communicating processes.
+     * @param ringSize The capacity (in bytes) of each ring.
+     * @param src The identifier of the process writing to the ring.
+     * @param dest The identifier of the process reading from the ring.
+     *
+     * @return The ring from src to dest.
+     */
+    Ring *ringOf(char *segment, int nbProcs, unsigned long ringSize, int src, int dest) {
+        auto *rings = segment + (nbProcs * sizeof(Doorbell));
+        return reinterpret_cast<Ring *>(rings + ((src * nbProcs + dest) * strideOf(ringSize)));
+    }
+
+}
+
+SharedMemoryCommunication::SharedMemoryCommunication(int id, int nbProcs, unsigned long ringSize, char *segment,
+                                                     unsigned long segmentSize) :
+        id(id),
+        nbProcs(nbProcs),
+        ringSize(ringSize),
+        segment(segment),
+        segmentSize(segmentSize),
+        sendMutexes(new std::mutex[nbProcs]),
+        incoming(nbProcs, PartialMessage {nullptr, {}, 0, 0}) {
+    // Nothing to do: everything is already initialized.
+}
+
+SharedMemoryCommunication *SharedMemoryCommunication::create(int nbProcesses, unsigned long ringSize) {
+    // Rings are kept aligned on cache lines.
+    ringSize = (max(ringSize, (unsigned long) sizeof(Message)) + PANO_CACHE_LINE_SIZE - 1)
+               & ~((unsigned long) PANO_CACHE_LINE_SIZE - 1);
+    unsigned long segmentSize = (nbProcesses * sizeof(Doorbell))
+                                + (nbProcesses * nbProcesses * strideOf(ringSize));
+
+    // The segment is unlinked as soon as it is mapped, so that it disappears with the processes.
+    string name = "/panoramyx-" + to_string(getpid());
+    int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0) {
+        throw IllegalStateException("cannot create shared memory segment: " + string(strerror(errno)));
+    }
+    if (ftruncate(fd, (off_t) segmentSize) < 0) {
+        close(fd);
+        shm_unlink(name.c_str());
+        throw IllegalStateException("cannot allocate shared memory segment: " + string(strerror(errno)));
+    }
+    void *address = mmap(nullptr, segmentSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    shm_unlink(name.c_str());
+    if (address == MAP_FAILED) {
+        throw IllegalStateException("cannot map shared memory segment: " + string(strerror(errno)));
+    }
+
+    auto *segment = static_cast<char *>(address);
+    for (int i = 0; i < nbProcesses; i++) {
+        new(doorbellOf(segment, i)) Doorbell();
+        for (int j = 0; j < nbProcesses; j++) {
+            new(ringOf(segment, nbProcesses, ringSize, i, j)) Ring();
+        }
+    }
+
+    // Forking the other processes, which inherit the mapping.
+    vector<pid_t> children;
+    for (int i = 1; i < nbProcesses; i++) {
+        pid_t pid = fork();
+        if (pid < 0) {
+            throw IllegalStateException("cannot fork process: " + string(strerror(errno)));
+        }
+        if (pid == 0) {
+            // Children must not survive the main process.
+            prctl(PR_SET_PDEATHSIG, SIGTERM);
+            return new SharedMemoryCommunication(i, nbProcesses, ringSize, segment, segmentSize);
+        }
+        children.push_back(pid);
+    }
+
+    auto *communication = new SharedMemoryCommunication(0, nbProcesses, ringSize, segment, segmentSize);
+    communication->children = children;
+    return communication;
+}
+
+SharedMemoryCommunication::~SharedMemoryCommunication() {
+    for (auto &partial : incoming) {
+        MessagePool::release(partial.message);
+    }
+    delete[] sendMutexes;
+}
+
+int SharedMemoryCommunication::getId() {
+    return id;
+}
+
+int SharedMemoryCommunication::nbProcesses() {
+    return nbProcs;
+}
+
+void SharedMemoryCommunication::start(function<void()> runnable) {
+    runnable();
+}
+
+void SharedMemoryCommunication::notify(int process) {
+    auto *doorbell = doorbellOf(segment, process);
+    doorbell->value.fetch_add(1);
+    if (doorbell->waiters.load() > 0) {
+        futexWake(&doorbell->value);
+    }
+}
+
+void SharedMemoryCommunication::write(const char *bytes, unsigned long length, int dest) {
+    auto *ring = ringOf(segment, nbProcs, ringSize, id, dest);
+    auto *data = ring->data();
+
+    for (unsigned long written = 0; written < length;) {
+        auto head = ring->head.load(memory_order_relaxed);
+        auto tail = ring->tail.load(memory_order_acquire);
+        auto available = ringSize - (head - tail);
+
+        if (available == 0) {
+            // The destination may itself be waiting for space to write to this process,
+            // so the incoming rings are read to let it progress.
+            {
+                scoped_lock lock(receiveMutex);
+                drain();
+            }
+
+            // Waiting for the destination to read the ring.
+            ring->waiters.fetch_add(1);
+            auto seen = ring->space.load();
+            if (ring->tail.load() == tail) {
+                futexWait(&ring->space, seen);
+            }
+            ring->waiters.fetch_sub(1);
+            continue;
+        }
+
+        // Copying as many bytes as possible, wrapping around the end of the ring.
+        auto n = min(available, length - written);
+        auto position = head % ringSize;
+        auto first = min(n, ringSize - position);
+        memcpy(data + position, bytes + written, first);
+        memcpy(data, bytes + written + first, n - first);
+        ring->head.store(head + n, memory_order_release);
+        notify(dest);
+        written += n;
+    }
+}
+
+void SharedMemoryCommunication::drain() {
+    for (int src = 0; src < nbProcs; src++) {
+        if (src == id) {
+            continue;
+        }
+
+        auto *ring = ringOf(segment, nbProcs, ringSize, src, id);
+        auto *data = ring->data();
+        auto head = ring->head.load(memory_order_acquire);
+        auto tail = ring->tail.load(memory_order_relaxed);
+        if (head == tail) {
+            continue;
+        }
+
+        auto &partial = incoming[src];
+        while (tail < head) {
+            // The header is read first, to know the size of the message.
+            char *target;
+            unsigned long missing;
+            if (partial.message == nullptr) {
+                target = partial.header + partial.received;
+                missing = sizeof(Message) - partial.received;
+            } else {
+                target = reinterpret_cast<char *>(partial.message) + partial.received;
+                missing = partial.total - partial.received;
+            }
+
+            auto n = min(missing, (unsigned long) (head - tail));
+            auto position = tail % ringSize;
+            auto first = min(n, ringSize - position);
+            memcpy(target, data + position, first);
+            memcpy(target + first, data, n - first);
+            tail += n;
+            partial.received += n;
+
+            if ((partial.message == nullptr) && (partial.received == sizeof(Message))) {
+                auto *header = reinterpret_cast<Message *>(partial.header);
+                partial.total = sizeof(Message) + header->size;
+                partial.message = MessagePool::allocate(partial.total);
+                memcpy(partial.message, partial.header, sizeof(Message));
+            }
+
+            if ((partial.message != nullptr) && (partial.received == partial.total)) {
+                mailbox.deliver(partial.message);
+                partial = PartialMessage {nullptr, {}, 0, 0};
+            }
+        }
+
+        // Letting the source know that there is space in the ring.
+        ring->tail.store(tail, memory_order_release);
+        ring->space.fetch_add(1);
+        if (ring->waiters.load() > 0) {
+            futexWake(&ring->space);
+        }
+    }
+}
+
+Message *SharedMemoryCommunication::tryReceive(int tag, int src) {
+    Message *message;
+    {
+        scoped_lock lock(receiveMutex);
+        drain();
+        message = mailbox.tryReceive(tag, src);
+    }
+
+    // Broadcast messages are forwarded without holding the lock.
+    return completeReceive(message);
+}
+
+Message *SharedMemoryCommunication::receive(int tag, int src) {
+    auto *doorbell = doorbellOf(segment, id);
+    for (;;) {
+        // Reading the doorbell before the rings ensures that no message is missed.
+        auto seen = doorbell->value.load();
+        auto *message = tryReceive(tag, src);
+        if (message != nullptr) {
+            return message;
+        }
+
+        doorbell->waiters.fetch_add(1);
+        if (doorbell->value.load() == seen) {
+            futexWait(&doorbell->value, seen);
+        }
+        doorbell->waiters.fetch_sub(1);
+    }
+}
+
+void SharedMemoryCommunication::send(Message *message, int dest) {
+    message->src = id;
+    unsigned long total = sizeof(Message) + message->size;
+
+    if (dest == id) {
+        // The message does not need to go through a ring.
+        auto *copiedMessage = MessagePool::allocate(total);
+        memcpy(copiedMessage, message, total);
+        mailbox.deliver(copiedMessage);
+        notify(id);
+        return;
+    }
+
+    scoped_lock lock(sendMutexes[dest]);
+    write(reinterpret_cast<const char *>(message), total, dest);
+}
+
+INetworkRequest *SharedMemoryCommunication::irecv(int tag, int src) {
+    return new SharedMemoryReceiveRequest(this, tag, src);
+}
+
+INetworkRequest *SharedMemoryCommunication::isend(Message *message, int dest) {
+    transfer(message, dest);
+    return new CompletedNetworkRequest();
+}
+
+void SharedMemoryCommunication::finalize() {
+    for (auto pid : children) {
+        waitpid(pid, nullptr, 0);
+    }
+    munmap(segment, segmentSize);
+}
@@ -0,0 +1,70 @@
+/**
+ * PANORAMYX - Programming pArallel coNstraint sOlveRs mAde aMazingly easY.
+ * Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see {@link http://www.gnu.org/licenses}.
+ */
+
+/**
+ * @file SharedMemoryReceiveRequest.cpp
+ * @brief A pending non-blocking receive through shared memory.
+ *
+ * @author Thibault Falque
+ * @author Romain Wallon
+ *
+ * @copyright Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#include <crillab-panoramyx/network/MessagePool.hpp>
+#include <crillab-panoramyx/network/SharedMemoryCommunication.hpp>
+#include <crillab-panoramyx/network/SharedMemoryReceiveRequest.hpp>
+
+using namespace Panoramyx;
+
+SharedMemoryReceiveRequest::SharedMemoryReceiveRequest(SharedMemoryCommunication *communication, int tag, int src) :
+        communication(communication),
+        tag(tag),
+        src(src),
+        completed(false),
+        message(nullptr) {
+    // Nothing to do: everything is already initialized.
+}
+
+SharedMemoryReceiveRequest::~SharedMemoryReceiveRequest() {
+    MessagePool::release(message);
+}
+
+bool SharedMemoryReceiveRequest::test() {
+    if (!completed) {
+        message = communication->tryReceive(tag, src);
+        completed = (message != nullptr);
+    }
+    return completed;
+}
+
+void SharedMemoryReceiveRequest::wait() {
+    if (!completed) {
+        message = communication->receive(tag, src);
+        completed = true;
+    }
+}
+
+Message *SharedMemoryReceiveRequest::getMessage() {
+    auto *received = message;
+    message = nullptr;
+    return received;
+}
@@ -29,59 +29,79 @@
  * @license This project is released under the GNU LGPL3 License.
  */
 
+#include <crillab-panoramyx/network/CompletedNetworkRequest.hpp>
+#include <crillab-panoramyx/network/MailboxReceiveRequest.hpp>
+#include <crillab-panoramyx/network/MessagePool.hpp>
 #include <crillab-panoramyx/network/ThreadCommunication.hpp>
 
 using namespace std;
 
 using namespace Panoramyx;
 
+thread_local int ThreadCommunication::threadId = 0;
+
 ThreadCommunication::ThreadCommunication(int nbThreads) :
         nbThreads(nbThreads) {
-    // Nothing to do: everything is already initialized.
+    for (int i = 0; i < nbThreads; i++) {
+        mailboxes.push_back(new MessageMailbox());
+    }
+}
+
+ThreadCommunication::~ThreadCommunication() {
+    for (auto *mailbox : mailboxes) {
+        delete mailbox;
+    }
 }
 
 int ThreadCommunication::getId() {
-    return ids[this_thread::get_id()];
+    return threadId;
 }
 
 int ThreadCommunication::nbProcesses() {
-    return (int) ids.size();
+    return nbThreads;
 }
 
 void ThreadCommunication::start(function<void()> runnable) {
     for (int i = 0; i < nbThreads; i++) {
-        threads.emplace_back(runnable);
-        ids[threads.back().get_id()] = i;
-        queues.emplace_back();
+        threads.emplace_back([runnable, i]() {
+            threadId = i;
+            runnable();
+        });
     }
 }
 
-Message *ThreadCommunication::receive(int tag, int src, unsigned long size) {
-    // FIXME PANO_ANY_TAG and PANO_ANY_SOURCE are not supported with this approach.
-    pair<int, int> k = make_pair(tag, src);
-    newqmutex.lock();
-    if (queues[this->getId()].find(k) == queues[this->getId()].end()) {
-        queues[this->getId()][k] = new BlockingDeque<Message *>();
-    }
-    newqmutex.unlock();
+function<void()> ThreadCommunication::attach(function<void()> runnable) {
+    int current = threadId;
+    return [runnable = std::move(runnable), current]() {
+        threadId = current;
+        runnable();
+    };
+}
 
-    return queues[this->getId()][{tag, src}]->get();
+Message *ThreadCommunication::receive(int tag, int src) {
+    return completeReceive(mailboxes[getId()]->receive(tag, src));
 }
 
 void ThreadCommunication::send(Message *message, int dest) {
-    // FIXME PANO_ANY_TAG and PANO_ANY_SOURCE are not supported with this approach.
-    Message *copiedMessage = static_cast<Message *>(malloc(sizeof(Message) + message->size));
+    // The caller keeps its message, so the destination receives a copy.
+    Message *copiedMessage = MessagePool::allocate(sizeof(Message) + message->size);
     memcpy(copiedMessage, message, sizeof(Message) + message->size);
-    copiedMessage->src = this->getId();
+    transfer(copiedMessage, dest);
+}
 
-    pair<int, int> k = make_pair(message->tag, message->src);
-    newqmutex.lock();
-    if (queues[dest].find(k) == queues[dest].end()) {
-        queues[dest][k] = new BlockingDeque<Message *>();
-    }
-    newqmutex.unlock();
+void ThreadCommunication::transfer(Message *message, int dest) {
+    message->src = getId();
+    mailboxes[dest]->deliver(message);
+}
+
+INetworkRequest *ThreadCommunication::irecv(int tag, int src) {
+    return new MailboxReceiveRequest(this, mailboxes[getId()], tag, src);
+}
 
-    queues[dest][{message->tag, message->src}]->add(copiedMessage);
+INetworkRequest *ThreadCommunication::isend(Message *message, int dest) {
+    // Sending a message never blocks with this approach.
+    transfer(message, dest);
+    return new CompletedNetworkRequest();
 }
 
 void ThreadCommunication::finalize() {
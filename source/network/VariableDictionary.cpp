@@ -0,0 +1,87 @@
+/**
+ * PANORAMYX - Programming pArallel coNstraint sOlveRs mAde aMazingly easY.
+ * Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see {@link http://www.gnu.org/licenses}.
+ */
+
+/**
+ * @file VariableDictionary.cpp
+ * @brief Assigns dense indices to the variables of a solver, to identify them in the messages.
+ *
+ * @author Thibault Falque
+ * @author Romain Wallon
+ *
+ * @copyright Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#include <crillab-except/except.hpp>
+
+#include <crillab-panoramyx/network/VariableDictionary.hpp>
+
+using namespace Panoramyx;
+using namespace std;
+
+VariableDictionary::VariableDictionary(vector<string> names) :
+        names(std::move(names)) {
+    indices.reserve(this->names.size());
+    for (unsigned long i = 0; i < this->names.size(); i++) {
+        indices.emplace(this->names[i], i);
+    }
+}
+
+unsigned long VariableDictionary::size() const {
+    return names.size();
+}
+
+void VariableDictionary::writeTo(MessageBuilder &builder) const {
+    builder.reserve(names.size() * PANO_VARIABLE_NAME_MAX_CHAR).withUnsigned(names.size());
+    for (auto &name : names) {
+        builder.withString(name);
+    }
+}
+
+VariableDictionary VariableDictionary::readFrom(MessageReader &reader) {
+    vector<string> names;
+    auto n = reader.readUnsigned();
+    names.reserve(n);
+    for (unsigned long long i = 0; i < n; i++) {
+        names.emplace_back(reader.readString());
+    }
+    return VariableDictionary(std::move(names));
+}
+
+void VariableDictionary::writeVariable(MessageBuilder &builder, const string &name) const {
+    // The index is shifted, as 0 announces that the name of the variable follows.
+    auto it = indices.find(name);
+    if (it == indices.end()) {
+        builder.withUnsigned(0).withString(name);
+    } else {
+        builder.withUnsigned(it->second + 1);
+    }
+}
+
+string VariableDictionary::readVariable(MessageReader &reader) const {
+    auto index = reader.readUnsigned();
+    if (index == 0) {
+        return string(reader.readString());
+    }
+    if (index > names.size()) {
+        throw Except::IllegalStateException("unknown variable #" + to_string(index - 1));
+    }
+    return names[index - 1];
+}
@@ -31,7 +31,6 @@
 
 #include <crillab-except/except.hpp>
 
-#include <crillab-panoramyx/network/MessageBuilder.hpp>
 #include <crillab-panoramyx/problem/RemoteConstraint.hpp>
 
 using namespace std;
@@ -40,11 +39,8 @@ using namespace Except;
 using namespace Panoramyx;
 using namespace Universe;
 
-RemoteConstraint::RemoteConstraint(
-        INetworkCommunication *communicator, std::mutex &mutex, int solverRank, int constraintIndex) :
-        communicator(communicator),
-        mutex(mutex),
-        solverRank(solverRank),
+RemoteConstraint::RemoteConstraint(PanoramyxSolver *solver, int constraintIndex) :
+        solver(solver),
         constraintIndex(constraintIndex) {
     // Nothing to do: everything is already initialized.
 }
@@ -54,39 +50,13 @@ const vector<IUniverseVariable *> &RemoteConstraint::scope() {
 }
 
 void RemoteConstraint::setIgnored(bool ignored) {
-    MessageBuilder mb;
-    mb.named(PANO_MESSAGE_CONSTRAINT_SET_IGNORED);
-    Message *m = mb.withTag(PANO_TAG_SOLVE).withParameter(constraintIndex).withParameter(ignored).build();
-    communicator->send(m, solverRank);
-    free(m);
+    solver->setConstraintIgnored(constraintIndex, ignored);
 }
 
 const bool RemoteConstraint::isIgnored() const {
-    mutex.lock();
-    MessageBuilder mb;
-    mb.named(PANO_MESSAGE_CONSTRAINT_IS_IGNORED)
-            .withParameter(constraintIndex);
-    Message *m = mb.withTag(PANO_TAG_RESPONSE).build();
-    communicator->send(m, solverRank);
-    free(m);
-    m = communicator->receive(PANO_TAG_RESPONSE, solverRank, PANO_DEFAULT_MESSAGE_SIZE);
-    mutex.unlock();
-    bool ignored = m->read<bool>();
-    free(m);
-    return ignored;
+    return solver->getIgnoredConstraintsAsync({constraintIndex}).get().at(0);
 }
 
 const double RemoteConstraint::getScore() const {
-    mutex.lock();
-    MessageBuilder mb;
-    mb.named(PANO_MESSAGE_CONSTRAINT_SCORE)
-            .withParameter(constraintIndex);
-    Message *m = mb.withTag(PANO_TAG_RESPONSE).build();
-    communicator->send(m, solverRank);
-    free(m);
-    m = communicator->receive(PANO_TAG_RESPONSE, solverRank, PANO_DEFAULT_MESSAGE_SIZE);
-    mutex.unlock();
-    double score = m->read<double>();
-    free(m);
-    return score;
+    return solver->getConstraintScoresAsync({constraintIndex}).get().at(0);
 }
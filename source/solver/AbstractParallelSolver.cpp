@@ -29,6 +29,8 @@
  * @license This project is released under the GNU LGPL3 License.
  */
 
+#include <filesystem>
+#include <fstream>
 #include <thread>
 
 #include <loguru.hpp>
@@ -36,6 +38,9 @@
 
 #include <crillab-panoramyx/solver/AbstractParallelSolver.hpp>
 #include <crillab-panoramyx/network/Message.hpp>
+#include <crillab-panoramyx/network/MessageBuilder.hpp>
+#include <crillab-panoramyx/network/MessageHandle.hpp>
+#include <crillab-panoramyx/network/MessageReader.hpp>
 
 using namespace std;
 
@@ -60,7 +65,8 @@ AbstractParallelSolver::AbstractParallelSolver(
         solutionMutex(),
         solved(0),
         interrupted(false),
-        end(0) {
+        end(0),
+        instanceBroadcast(false) {
     currentBounds.emplace_back(0);
 }
 
@@ -77,11 +83,49 @@ void AbstractParallelSolver::addSolver(PanoramyxSolver *solver) {
 }
 
 void AbstractParallelSolver::loadInstance(const string &filename) {
+    if (!instanceBroadcast) {
+        for (auto &solver: solvers) {
+            solver->loadInstance(filename);
+        }
+        return;
+    }
+
+    // Reading the instance once, to send its content to all the solvers.
+    ifstream input(filename, ios::binary);
+    if (!input) {
+        throw IllegalArgumentException("cannot read instance " + filename);
+    }
+    auto size = (unsigned long) filesystem::file_size(filename);
+    MessageBuilder mb;
+    mb.withOpcode(MessageOpcode::INSTANCE_DATA)
+            .withTag(PANO_TAG_SOLVE)
+            .withString(filesystem::path(filename).filename().string());
+
+    // Each solver is told the identifier of the request its acknowledgment answers.
+    vector<unsigned int> requestIds;
+    requestIds.reserve(solvers.size());
+    mb.withUnsigned(solvers.size());
+    for (auto &solver: solvers) {
+        requestIds.push_back(solver->expectInstance());
+        mb.withInteger(solver->getRank()).withUnsigned(requestIds.back());
+    }
+    mb.withStream(input, size);
+    LOG_F(INFO, "broadcasting instance %s (%lu bytes)", filename.c_str(), size);
+    broadcastToSolvers(mb.build());
+
+    // Waiting for all the solvers to have received the instance before loading it.
+    for (unsigned i = 0; i < solvers.size(); i++) {
+        solvers[i]->awaitInstance(requestIds[i]);
+    }
     for (auto &solver: solvers) {
-        solver->loadInstance(filename);
+        solver->loadReceivedInstance();
     }
 }
 
+void AbstractParallelSolver::setInstanceBroadcast(bool instanceBroadcast) {
+    this->instanceBroadcast = instanceBroadcast;
+}
+
 void AbstractParallelSolver::reset() {
     // FIXME: Make sure that the semaphores, etc. are also reset.
     for (auto &solver: solvers) {
@@ -179,6 +223,8 @@ UniverseSolverResult AbstractParallelSolver::solve(const vector<UniverseAssumpti
 }
 
 void AbstractParallelSolver::interrupt() {
+    // The interruption is sent to each solver on its own channel, so that it cannot overtake
+    // the messages (such as the solve request) that have been sent to this solver before.
     for (auto &solver : solvers) {
         solver->interrupt();
     }
@@ -267,39 +313,51 @@ BigInteger AbstractParallelSolver::getCurrentBound() {
 }
 
 void AbstractParallelSolver::readMessages() {
-    thread receiver([this]() {
+    thread receiver(communicator->attach([this]() {
         while (runningSolvers > 0) {
-            auto message = communicator->receive(PANO_TAG_SOLVE, PANO_ANY_SOURCE, PANO_DEFAULT_MESSAGE_SIZE);
-            readMessage(message);
-            free(message);
+            MessageHandle message(communicator->receive(PANO_TAG_SOLVE, PANO_ANY_SOURCE));
+            readMessage(message.get());
         }
-    });
+    }));
     receiver.detach();
 }
 
 void AbstractParallelSolver::readMessage(const Message *message) {
-    LOG_F(INFO, "main solver #%d received a message '%s' from %d", communicator->getId(), message->name, message->src);
-
-    if (NAME_OF(message, IS(PANO_MESSAGE_SATISFIABLE))) {
-        readSatisfiable(message);
-
-    } else if (NAME_OF(message, IS(PANO_MESSAGE_NEW_BOUND_FOUND))) {
-        readBound(message);
-
-    } else if (NAME_OF(message, IS(PANO_MESSAGE_UNSATISFIABLE))) {
-        readUnsatisfiable(message);
-
-    } else if (NAME_OF(message, IS(PANO_MESSAGE_UNKNOWN))) {
-        readUnknown(message);
-
-    } else if (NAME_OF(message, IS(PANO_MESSAGE_END_SEARCH_ACK))) {
-        readEnd(message);
-    }
+    LOG_F(INFO, "main solver #%d received a message '%s' from %d", communicator->getId(), nameOf(message->opcode), message->src);
+    dispatcher().dispatch(*this, message);
+}
+
+const MessageDispatcher<AbstractParallelSolver, const Message> &AbstractParallelSolver::dispatcher() {
+    static const MessageDispatcher<AbstractParallelSolver, const Message> table =
+            MessageDispatcher<AbstractParallelSolver, const Message>("main solver")
+                    .on(MessageOpcode::SATISFIABLE, [](AbstractParallelSolver &s, const Message *m) {
+                        s.readSatisfiable(m);
+                    })
+                    .on(MessageOpcode::NEW_BOUND_FOUND, [](AbstractParallelSolver &s, const Message *m) {
+                        s.readBound(m);
+                    })
+                    .on(MessageOpcode::UNSATISFIABLE, [](AbstractParallelSolver &s, const Message *m) {
+                        s.readUnsatisfiable(m);
+                    })
+                    .on(MessageOpcode::UNKNOWN, [](AbstractParallelSolver &s, const Message *m) {
+                        s.readUnknown(m);
+                    })
+                    .on(MessageOpcode::END_SEARCH_ACK, [](AbstractParallelSolver &s, const Message *m) {
+                        s.readEnd(m);
+                    })
+                    .on(MessageOpcode::CONSTRAINTS_SCORE, [](AbstractParallelSolver &s, const Message *m) {
+                        s.readConstraintScores(m);
+                    });
+    return table;
 }
 
 void AbstractParallelSolver::readSatisfiable(const Panoramyx::Message *message) {
     LOG_F(INFO, "sat received");
-    winner = message->read<unsigned>();
+    MessageReader reader(message);
+    winner = reader.read<unsigned>();
+    if ((message->flags & PANO_FLAG_SOLUTION) != 0) {
+        solvers[winner]->readAttachedSolution(reader);
+    }
     currentRunningSolvers[winner] = false;
     result = UniverseSolverResult::SATISFIABLE;
     onSatisfiableFound(winner);
@@ -307,9 +365,13 @@ void AbstractParallelSolver::readSatisfiable(const Panoramyx::Message *message)
 }
 
 void AbstractParallelSolver::readBound(const Panoramyx::Message *message) {
-    auto src = message->read<unsigned>();
-    string param(message->parameters + sizeof(unsigned), strlen(message->parameters + sizeof(unsigned)) + 1);
-    BigInteger newBound = Universe::bigIntegerValueOf(param);
+    MessageReader reader(message);
+    auto src = reader.read<unsigned>();
+    BigInteger newBound = reader.readBigInteger();
+    solvers[src]->invalidateMetadata();
+    if ((message->flags & PANO_FLAG_SOLUTION) != 0) {
+        solvers[src]->readAttachedSolution(reader);
+    }
     result = UniverseSolverResult::SATISFIABLE;
     LOG_F(INFO, "solver #%d sent its current bound: %s", src, Universe::toString(newBound).c_str());
     currentRunningSolvers[src] = false;
@@ -336,6 +398,12 @@ void AbstractParallelSolver::readEnd(const Panoramyx::Message *message) {
     }
 }
 
+void AbstractParallelSolver::readConstraintScores(const Panoramyx::Message *message) {
+    MessageReader reader(message);
+    auto src = reader.read<unsigned>();
+    solvers[src]->readConstraintScores(reader);
+}
+
 void AbstractParallelSolver::ready(unsigned solverIndex) {
     // Nothing to do by default.
 }
@@ -351,8 +419,10 @@ void AbstractParallelSolver::beforeSearch(unsigned int solverIndex) {
 void AbstractParallelSolver::onSatisfiableFound(unsigned int solverIndex) {
     if (!interrupted) {
         solutionMutex.lock();
-        bestSolution = solvers[solverIndex]->mapSolution();
-        bestSolutionVector = solvers[solverIndex]->solution();
+        auto mapped = solvers[solverIndex]->mapSolutionAsync(false);
+        auto assignment = solvers[solverIndex]->solutionAsync();
+        bestSolution = mapped.get();
+        bestSolutionVector = assignment.get();
         solutionMutex.unlock();
     }
 }
@@ -374,9 +444,33 @@ void AbstractParallelSolver::updateBounds() {
 }
 
 void AbstractParallelSolver::endSearch() {
+    MessageBuilder mb;
+    broadcastToSolvers(mb.withOpcode(MessageOpcode::END_SEARCH).withTag(PANO_TAG_SOLVE).build());
+}
+
+void AbstractParallelSolver::flushSolvers() {
     for (auto &solver: solvers) {
-        solver->endSearch();
+        solver->flush();
+    }
+}
+
+void AbstractParallelSolver::restart(PanoramyxSolver *solver) {
+    if ((solver->getCapabilities() & PANO_CAPABILITY_INCREMENTAL) != 0) {
+        solver->restore();
+    } else {
+        solver->reset();
+    }
+}
+
+void AbstractParallelSolver::broadcastToSolvers(Message *message) {
+    MessageHandle handle(message);
+    flushSolvers();
+    vector<int> ranks;
+    ranks.reserve(solvers.size());
+    for (auto &solver : solvers) {
+        ranks.push_back(solver->getRank());
     }
+    communicator->broadcast(message, ranks);
 }
 
 UniverseSolverResult AbstractParallelSolver::internalSolve(const vector<UniverseAssumption<BigInteger>> &assumpts) {
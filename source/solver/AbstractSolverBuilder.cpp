@@ -64,6 +64,11 @@ AbstractSolverBuilder *AbstractSolverBuilder::withNetworkCommunicator(INetworkCo
     return this;
 }
 
+AbstractSolverBuilder *AbstractSolverBuilder::withInstanceBroadcast(bool instanceBroadcast) {
+    this->instanceBroadcast = instanceBroadcast;
+    return this;
+}
+
 void AbstractSolverBuilder::buildJVM() {
     if (!jars.empty()) {
         JavaVirtualMachineBuilder builder = JavaVirtualMachineBuilder();
@@ -58,7 +58,7 @@ void EPSSolver::ready(unsigned solverIndex) {
 }
 
 void EPSSolver::startSearch() {
-    std::thread solvingThread([this]() {
+    std::thread solvingThread(communicator->attach([this]() {
         int nbCubes = 0;
 
         // Generating the cubes, and assigning them to the different solvers.
@@ -91,7 +91,7 @@ void EPSSolver::startSearch() {
         // We must wait for the solvers to solve them.
         waitForAllCubes(nbCubes);
         LOG_F(INFO, "fini");
-    });
+    }));
 
     solvingThread.detach();
 }
@@ -109,7 +109,7 @@ void EPSSolver::onSatisfiableFound(unsigned solverIndex) {
 
 void EPSSolver::onUnsatisfiableFound(unsigned solverIndex) {
     nbUnsat++;
-    solvers[solverIndex]->reset();
+    restart(solvers[solverIndex]);
     availableSolvers.add(solvers[solverIndex]);
     cubes.release();
 }
@@ -40,5 +40,7 @@ EPSSolverBuilder *EPSSolverBuilder::withCubeGenerator(ICubeGenerator *cubeGenera
 }
 
 AbstractParallelSolver *EPSSolverBuilder::build() {
-    return new EPSSolver(this->networkCommunication, this->cubeGenerator);
+    auto *solver = new EPSSolver(this->networkCommunication, this->cubeGenerator);
+    solver->setInstanceBroadcast(instanceBroadcast);
+    return solver;
 }
@@ -34,6 +34,7 @@
 #include <crillab-panoramyx/solver/GauloisPartitionSolver.hpp>
 #include "mpi.h"
 #include "crillab-panoramyx/network/MessageBuilder.hpp"
+#include "crillab-panoramyx/network/MessageHandle.hpp"
 
 using namespace Panoramyx;
 
@@ -45,16 +46,36 @@ GauloisPartitionSolver::GauloisPartitionSolver(Panoramyx::PartitionSolver *solve
 }
 void GauloisPartitionSolver::start() {
     while (partitionSolver->getRunningSolvers() > 0) {
-        auto message = comm->receive(PANO_ANY_TAG, MPI_ANY_SOURCE, PANO_DEFAULT_MESSAGE_SIZE);
-        LOG_F(INFO, "GauloisPartitionSolver: readMessage - %s", message->name);
-        if (NAME_OF(message, IS(PANO_MESSAGE_END_SEARCH))) {
-            partitionSolver->endSearch();
-        } else if (NAME_OF(message, IS(PANO_MESSAGE_END_SEARCH_ACK))) {
-            partitionSolver->readEnd(message);
-        } else {
+        MessageHandle handle(comm->receive(PANO_ANY_TAG, MPI_ANY_SOURCE));
+        auto *message = handle.get();
+        LOG_F(INFO, "GauloisPartitionSolver: readMessage - %s", nameOf(message->opcode));
+        if (!dispatcher().tryDispatch(*this, message)) {
             readMessage(message);
         }
-        free(message);
     }
     LOG_F(INFO, "After loop message");
-}
\ No newline at end of file
+}
+
+const MessageDispatcher<GauloisPartitionSolver> &GauloisPartitionSolver::dispatcher() {
+    static const MessageDispatcher<GauloisPartitionSolver> table =
+            MessageDispatcher<GauloisPartitionSolver>("GauloisPartitionSolver")
+                    .on(MessageOpcode::END_SEARCH, [](GauloisPartitionSolver &s, Message *) {
+                        s.partitionSolver->endSearch();
+                    })
+                    .on(MessageOpcode::END_SEARCH_ACK, [](GauloisPartitionSolver &s, Message *m) {
+                        s.partitionSolver->readEnd(m);
+                    })
+                    .on(MessageOpcode::SATISFIABLE, [](GauloisPartitionSolver &s, Message *m) {
+                        s.partitionSolver->readSatisfiable(m);
+                    })
+                    .on(MessageOpcode::NEW_BOUND_FOUND, [](GauloisPartitionSolver &s, Message *m) {
+                        s.partitionSolver->readBound(m);
+                    })
+                    .on(MessageOpcode::UNSATISFIABLE, [](GauloisPartitionSolver &s, Message *m) {
+                        s.partitionSolver->readUnsatisfiable(m);
+                    })
+                    .on(MessageOpcode::UNKNOWN, [](GauloisPartitionSolver &s, Message *m) {
+                        s.partitionSolver->readUnknown(m);
+                    });
+    return table;
+}
@@ -30,29 +30,39 @@
  */
 
 #include <cassert>
+#include <filesystem>
 #include <fstream>
 #include <thread>
 
+#include <unistd.h>
+
 #include <mpi.h>
 
 #include <loguru.hpp>
 
 #include <crillab-easyjni/JavaVirtualMachineRegistry.h>
+#include <crillab-except/except.hpp>
 
 #include <crillab-panoramyx/network/Message.hpp>
 #include <crillab-panoramyx/network/MessageBuilder.hpp>
+#include <crillab-panoramyx/network/MessageDispatcher.hpp>
+#include <crillab-panoramyx/network/MessageHandle.hpp>
+#include <crillab-panoramyx/network/MessagePool.hpp>
+#include <crillab-panoramyx/network/MessageReader.hpp>
 #include <crillab-panoramyx/solver/GauloisSolver.hpp>
-#include <crillab-panoramyx/solver/AbstractParallelSolver.hpp>
 
 using namespace Panoramyx;
 using namespace std;
 
 GauloisSolver::GauloisSolver(Universe::IUniverseSolver *solver, INetworkCommunication *comm) : solver(solver),
-                                                                                               comm(comm) {
+                                                                                               comm(comm),
+                                                                                               executor([]() {
+    // The solving thread is only detached from the JVM when the solver is done.
+    easyjni::JavaVirtualMachineRegistry::detachCurrentThread();
+}) {
 }
 
 Universe::UniverseSolverResult GauloisSolver::solve() {
-    nbSolved++;
     auto r = solver->solve();
     LOG_F(INFO, "result after solve(): %s",
           r == Universe::UniverseSolverResult::SATISFIABLE ? "satisfiable" : "unsatisfiable");
@@ -60,7 +70,6 @@ Universe::UniverseSolverResult GauloisSolver::solve() {
 }
 
 Universe::UniverseSolverResult GauloisSolver::solve(const std::string &filename) {
-    nbSolved++;
     loadInstance(filename);
     auto result = solver->solve();
     return result;
@@ -68,8 +77,6 @@ Universe::UniverseSolverResult GauloisSolver::solve(const std::string &filename)
 
 Universe::UniverseSolverResult
 GauloisSolver::solve(const std::vector<Universe::UniverseAssumption<Universe::BigInteger>> &asumpts) {
-
-    nbSolved++;
     auto r = solver->solve(asumpts);
     LOG_F(INFO, "result after solve(assumpts): %s",
           r == Universe::UniverseSolverResult::SATISFIABLE ? "satisfiable" : "unsatisfiable");
@@ -99,9 +106,25 @@ void GauloisSolver::reset() {
     loadMutex.lock();
     LOG_F(INFO, "call reset");
     solver->reset();
+    instanceModified = false;
     loadMutex.unlock();
 }
 
+void GauloisSolver::restore() {
+    if (((capabilities & PANO_CAPABILITY_INCREMENTAL) != 0) && !instanceModified) {
+        // The solver keeps its root state between the searches.
+        LOG_F(INFO, "restoring without reset");
+        return;
+    }
+    reset();
+}
+
+void GauloisSolver::getCapabilities(Message *m) {
+    MessageBuilder mb;
+    mb.withOpcode(MessageOpcode::GET_CAPABILITIES).withUnsigned(capabilities);
+    comm->transfer(mb.inResponseTo(m).build(), m->src);
+}
+
 std::vector<Universe::BigInteger> GauloisSolver::solution() {
     return sol;
 }
@@ -122,195 +145,363 @@ void GauloisSolver::setLogFile(const std::string &filename) {
     loguru::add_file(filename.c_str(), loguru::Append, loguru::Verbosity_INFO);
 }
 
+void GauloisSolver::setSolutionAttachmentLimit(unsigned long limit) {
+    this->solutionAttachmentLimit = limit;
+}
+
+void GauloisSolver::setSolutionDelta(bool solutionDelta) {
+    this->solutionDelta = solutionDelta;
+}
+
+void GauloisSolver::setCapabilities(unsigned capabilities) {
+    this->capabilities = capabilities;
+}
+
 void GauloisSolver::start() {
     while (!finishedB) {
-        auto message = comm->receive(PANO_ANY_TAG, MPI_ANY_SOURCE, PANO_DEFAULT_MESSAGE_SIZE);
-        readMessage(message);
-        if (NAME_OF(message, PANO_MESSAGE_END_SEARCH)) {
+        MessageHandle message(comm->receive(PANO_ANY_TAG, MPI_ANY_SOURCE));
+        readMessage(message.get());
+        if (message->opcode == MessageOpcode::END_SEARCH) {
             break;
         }
-        free(message);
-    }
-    for (int i = 0; i < nbSolved; i++) {
-        finished.acquire();
     }
+
+    // Waiting for the current search (if any) to send its result.
+    executor.shutdown();
 }
 
 void GauloisSolver::readMessage(Message *m) {
-    LOG_F(INFO, "Gaulois Solver: readMessage - %s", m->name);
-    if (NAME_OF(m, IS(PANO_MESSAGE_SOLVE_FILENAME))) {
-        std::string filename(m->parameters);
-        this->solve(filename, m);
-    } else if (NAME_OF(m, IS(PANO_MESSAGE_SOLVE))) {
-        this->solve(m);
-    } else if (NAME_OF(m, IS(PANO_MESSAGE_INDEX))) {
-        this->index = m->read<unsigned>();
-        LOG_F(INFO, "Setting index to %d", index);
-    } else if (NAME_OF(m, IS(PANO_MESSAGE_SOLVE_ASSUMPTIONS))) {
-        std::vector<Universe::UniverseAssumption<Universe::BigInteger>> assumpts;
-        for (int i = 0, n = 0; n < m->nbParameters; n += 3) {
-            int s = (int) strlen(m->parameters + i);
-            char *ptr = m->parameters + i;
-            std::string varId(ptr, s);
-            i += s + 1;
-            bool equal = m->read<bool>(i);
-            i += sizeof(bool);
-            ptr = m->parameters + i;
-            std::string param(ptr, strlen(ptr) + 1);
-            LOG_F(INFO, "%s %s '%s'", varId.c_str(), equal ? "=" : "!=", param.c_str());
-            LOG_F(INFO, "%ld %ld %d", param.size(), strlen(ptr), s);
-            Universe::BigInteger tmp = Universe::bigIntegerValueOf(param);
-            assumpts.emplace_back(varId, equal, tmp);
-            i += param.size();
-        }
-        this->solve(assumpts, m);
-    } else if (strncmp(m->name, PANO_MESSAGE_RESET, sizeof(m->name)) == 0) {
-        this->reset();
-    } else if (strncmp(m->name, PANO_MESSAGE_LOAD_INSTANCE, sizeof(m->name)) == 0) {
-        std::string filename(m->parameters);
-        this->loadInstance(filename);
-    } else if (strncmp(m->name, PANO_MESSAGE_INTERRUPT, sizeof(m->name)) == 0) {
-        this->interrupt();
-    } else if (strncmp(m->name, PANO_MESSAGE_SET_TIMEOUT, sizeof(m->name)) == 0) {
-        auto timeout = m->read<long>();
-        this->setTimeout(timeout);
-    } else if (strncmp(m->name, PANO_MESSAGE_SET_TIMEOUT_MS, sizeof(m->name)) == 0) {
-        auto timeout = m->read<long>();
-        this->setTimeoutMs(timeout);
-    } else if (strncmp(m->name, PANO_MESSAGE_SET_VERBOSITY, sizeof(m->name)) == 0) {
-        int level = m->read<int>();
-        this->setVerbosity(level);
-    } else if (strncmp(m->name, PANO_MESSAGE_SET_LOG_FILE, sizeof(m->name)) == 0) {
-        std::string filename(m->parameters);
-        this->setLogFile(filename);
-    } else if (strncmp(m->name, PANO_MESSAGE_END_SEARCH, sizeof(m->name)) == 0) {
-        interrupt();
-        MessageBuilder mb;
-        Message *r = mb.named(PANO_MESSAGE_END_SEARCH_ACK).withTag(PANO_TAG_SOLVE).build();
-        comm->send(r, m->src);
-        free(r);
-        finishedB = true;
-    } else if (strncmp(m->name, PANO_MESSAGE_LOWER_BOUND, sizeof(m->name)) == 0) {
-        std::string param(m->parameters, strlen(m->parameters) + 1);
-        Universe::BigInteger newBound = Universe::bigIntegerValueOf(param);
-        this->setLowerBound(newBound);
-    } else if (strncmp(m->name, PANO_MESSAGE_UPPER_BOUND, sizeof(m->name)) == 0) {
-        std::string param(m->parameters, strlen(m->parameters) + 1);
-        Universe::BigInteger newBound = Universe::bigIntegerValueOf(param);
-        this->setUpperBound(newBound);
-    } else if (strncmp(m->name, PANO_MESSAGE_LOWER_UPPER_BOUND, sizeof(m->name)) == 0) {
-        std::string param(m->parameters, strlen(m->parameters) + 1);
-        Universe::BigInteger lowerBound = Universe::bigIntegerValueOf(param);
-
-        std::string param2(m->parameters + param.size(), strlen(m->parameters + param.size()) + 1);
-        Universe::BigInteger upperBound = Universe::bigIntegerValueOf(param2);
-        this->setBounds(lowerBound, upperBound);
-    } else if (strncmp(m->name, PANO_MESSAGE_GET_CURRENT_BOUND, sizeof(m->name)) == 0) {
-        this->getCurrentBound(m);
-    } else if (strncmp(m->name, PANO_MESSAGE_GET_LOWER_BOUND, sizeof(m->name)) == 0) {
-        this->getLowerBound(m);
-    } else if (strncmp(m->name, PANO_MESSAGE_GET_UPPER_BOUND, sizeof(m->name)) == 0) {
-        this->getUpperBound(m);
-    } else if (strncmp(m->name, PANO_MESSAGE_IS_MINIMIZATION, sizeof(m->name)) == 0) {
-        this->isMinimization(m);
-    } else if (strncmp(m->name, PANO_MESSAGE_IS_OPTIMIZATION, sizeof(m->name)) == 0) {
-        this->isOptimization(m);
-    } else if (NAME_OF(m, IS(PANO_MESSAGE_MAP_SOLUTION))) {
-        this->mapSolution(m);
-    } else if (NAME_OF(m, IS(PANO_MESSAGE_SOLUTION))) {
-        this->solution(m);
-    } else if (NAME_OF(m, IS(PANO_MESSAGE_N_VARIABLES))) {
-        this->nVariables(m);
-    } else if (NAME_OF(m, IS(PANO_MESSAGE_N_CONSTRAINTS))) {
-        this->nConstraints(m);
-    } else if (NAME_OF(m, IS(PANO_MESSAGE_DECISION_VARIABLES))) {
-        this->decisionVariables(m);
-    } else if (NAME_OF(m, IS(PANO_MESSAGE_GET_AUXILIARY_VARIABLES))) {
-        this->getAuxiliaryVariables(m);
-    } else if (NAME_OF(m, IS(PANO_MESSAGE_CHECK_SOLUTION))) {
-        this->checkSolution(m);
-    } else if (NAME_OF(m, IS(PANO_MESSAGE_CHECK_SOLUTION_ASSIGNMENT))) {
-        this->checkSolutionAssignment(m);
-    } else if (NAME_OF(m, IS(PANO_MESSAGE_VALUE_HEURISTIC_STATIC))) {
-        this->valueHeuristicStatic(m);
-    } else if (NAME_OF(m, IS(PANO_MESSAGE_CONSTRAINT_SCORE))) {
-        this->getConstraintScore(m);
-    } else if (NAME_OF(m, IS(PANO_MESSAGE_CONSTRAINT_SET_IGNORED))) {
-        this->setConstraintIgnored(m);
-    } else if (NAME_OF(m, IS(PANO_MESSAGE_CONSTRAINT_IS_IGNORED))) {
-        this->isConstraintIgnored(m);
-    }if (NAME_OF(m, IS(PANO_MESSAGE_SATISFIABLE))) {
-        ((AbstractParallelSolver *) solver)->readSatisfiable(m);
-
-    } else if (NAME_OF(m, IS(PANO_MESSAGE_NEW_BOUND_FOUND))) {
-        ((AbstractParallelSolver *) solver)->readBound(m);
-
-    } else if (NAME_OF(m, IS(PANO_MESSAGE_UNSATISFIABLE))) {
-        ((AbstractParallelSolver *) solver)->readUnsatisfiable(m);
-
-    } else if (NAME_OF(m, IS(PANO_MESSAGE_UNKNOWN))) {
-        ((AbstractParallelSolver *) solver)->readUnknown(m);
-    } else if (NAME_OF(m, IS(PANO_MESSAGE_END_SEARCH_ACK))) {
-        ((AbstractParallelSolver *) solver)->readEnd(m);
+    LOG_F(INFO, "Gaulois Solver: readMessage - %s", nameOf(m->opcode));
+    dispatcher().dispatch(*this, m);
+}
+
+const MessageDispatcher<GauloisSolver> &GauloisSolver::dispatcher() {
+    static const MessageDispatcher<GauloisSolver> table = MessageDispatcher<GauloisSolver>("Gaulois Solver")
+            .on(MessageOpcode::SOLVE_FILENAME, [](GauloisSolver &s, Message *m) {
+                MessageReader reader(m);
+                std::string filename(reader.readString());
+                s.solve(filename, m);
+            })
+            .on(MessageOpcode::SOLVE, [](GauloisSolver &s, Message *m) {
+                s.solve(m);
+            })
+            .on(MessageOpcode::CONFIGURE, [](GauloisSolver &s, Message *m) {
+                s.configure(m);
+            })
+            .on(MessageOpcode::INDEX, [](GauloisSolver &s, Message *m) {
+                s.index = m->read<unsigned>();
+                LOG_F(INFO, "Setting index to %d", s.index);
+            })
+            .on(MessageOpcode::SOLVE_ASSUMPTIONS, [](GauloisSolver &s, Message *m) {
+                std::vector<Universe::UniverseAssumption<Universe::BigInteger>> assumpts;
+                MessageReader reader(m);
+                std::scoped_lock lock(s.dictionaryMutex);
+                auto n = reader.readUnsigned();
+                assumpts.reserve(n);
+                for (unsigned long long i = 0; i < n; i++) {
+                    std::string varId(s.dictionary.readVariable(reader));
+                    bool equal = reader.read<bool>();
+                    Universe::BigInteger value = reader.readBigInteger();
+                    LOG_F(INFO, "%s %s '%s'", varId.c_str(), equal ? "=" : "!=", Universe::toString(value).c_str());
+                    assumpts.emplace_back(varId, equal, value);
+                }
+                s.solve(assumpts, m);
+            })
+            .on(MessageOpcode::RESET, [](GauloisSolver &s, Message *) {
+                s.reset();
+            })
+            .on(MessageOpcode::RESTORE, [](GauloisSolver &s, Message *) {
+                s.restore();
+            })
+            .on(MessageOpcode::GET_CAPABILITIES, [](GauloisSolver &s, Message *m) {
+                s.getCapabilities(m);
+            })
+            .on(MessageOpcode::LOAD_INSTANCE, [](GauloisSolver &s, Message *m) {
+                MessageReader reader(m);
+                std::string filename(reader.readString());
+                s.loadInstance(filename);
+            })
+            .on(MessageOpcode::INSTANCE_DATA, [](GauloisSolver &s, Message *m) {
+                s.receiveInstance(m);
+            })
+            .on(MessageOpcode::LOAD_RECEIVED_INSTANCE, [](GauloisSolver &s, Message *) {
+                s.loadReceivedInstance();
+            })
+            .on(MessageOpcode::INTERRUPT, [](GauloisSolver &s, Message *) {
+                s.interrupt();
+            })
+            .on(MessageOpcode::SET_TIMEOUT, [](GauloisSolver &s, Message *m) {
+                s.setTimeout(m->read<long>());
+            })
+            .on(MessageOpcode::SET_TIMEOUT_MS, [](GauloisSolver &s, Message *m) {
+                s.setTimeoutMs(m->read<long>());
+            })
+            .on(MessageOpcode::SET_VERBOSITY, [](GauloisSolver &s, Message *m) {
+                s.setVerbosity(m->read<int>());
+            })
+            .on(MessageOpcode::SET_LOG_FILE, [](GauloisSolver &s, Message *m) {
+                MessageReader reader(m);
+                std::string filename(reader.readString());
+                s.setLogFile(filename);
+            })
+            .on(MessageOpcode::END_SEARCH, [](GauloisSolver &s, Message *m) {
+                // The searches that have not started yet are cancelled, and the current one is interrupted.
+                auto cancelled = s.executor.cancelPending();
+                LOG_F(INFO, "cancelled %lu pending searches", cancelled);
+                s.unsubscribeConstraintsScore();
+                s.interrupt();
+                MessageBuilder mb;
+                Message *r = mb.withOpcode(MessageOpcode::END_SEARCH_ACK).withTag(PANO_TAG_SOLVE).build();
+                s.comm->transfer(r, m->src);
+                s.finishedB = true;
+            })
+            .on(MessageOpcode::LOWER_BOUND, [](GauloisSolver &s, Message *m) {
+                MessageReader reader(m);
+                s.setLowerBound(reader.readBigInteger());
+            })
+            .on(MessageOpcode::UPPER_BOUND, [](GauloisSolver &s, Message *m) {
+                MessageReader reader(m);
+                s.setUpperBound(reader.readBigInteger());
+            })
+            .on(MessageOpcode::LOWER_UPPER_BOUND, [](GauloisSolver &s, Message *m) {
+                MessageReader reader(m);
+                Universe::BigInteger lowerBound = reader.readBigInteger();
+                Universe::BigInteger upperBound = reader.readBigInteger();
+                s.setBounds(lowerBound, upperBound);
+            })
+            .on(MessageOpcode::GET_CURRENT_BOUND, [](GauloisSolver &s, Message *m) {
+                s.getCurrentBound(m);
+            })
+            .on(MessageOpcode::GET_LOWER_BOUND, [](GauloisSolver &s, Message *m) {
+                s.getLowerBound(m);
+            })
+            .on(MessageOpcode::GET_UPPER_BOUND, [](GauloisSolver &s, Message *m) {
+                s.getUpperBound(m);
+            })
+            .on(MessageOpcode::IS_MINIMIZATION, [](GauloisSolver &s, Message *m) {
+                s.isMinimization(m);
+            })
+            .on(MessageOpcode::GET_METADATA, [](GauloisSolver &s, Message *m) {
+                s.getMetadata(m);
+            })
+            .on(MessageOpcode::GET_VARIABLES_MAPPING, [](GauloisSolver &s, Message *m) {
+                s.sendVariableDictionary(m);
+            })
+            .on(MessageOpcode::IS_OPTIMIZATION, [](GauloisSolver &s, Message *m) {
+                s.isOptimization(m);
+            })
+            .on(MessageOpcode::MAP_SOLUTION, [](GauloisSolver &s, Message *m) {
+                s.mapSolution(m);
+            })
+            .on(MessageOpcode::SOLUTION, [](GauloisSolver &s, Message *m) {
+                s.solution(m);
+            })
+            .on(MessageOpcode::N_VARIABLES, [](GauloisSolver &s, Message *m) {
+                s.nVariables(m);
+            })
+            .on(MessageOpcode::N_CONSTRAINTS, [](GauloisSolver &s, Message *m) {
+                s.nConstraints(m);
+            })
+            .on(MessageOpcode::DECISION_VARIABLES, [](GauloisSolver &s, Message *m) {
+                s.decisionVariables(m);
+            })
+            .on(MessageOpcode::GET_AUXILIARY_VARIABLES, [](GauloisSolver &s, Message *m) {
+                s.getAuxiliaryVariables(m);
+            })
+            .on(MessageOpcode::CHECK_SOLUTION, [](GauloisSolver &s, Message *m) {
+                s.checkSolution(m);
+            })
+            .on(MessageOpcode::CHECK_SOLUTION_ASSIGNMENT, [](GauloisSolver &s, Message *m) {
+                s.checkSolutionAssignment(m);
+            })
+            .on(MessageOpcode::VALUE_HEURISTIC_STATIC, [](GauloisSolver &s, Message *m) {
+                s.valueHeuristicStatic(m);
+            })
+            .on(MessageOpcode::CONSTRAINT_SCORE, [](GauloisSolver &s, Message *m) {
+                s.getConstraintScore(m);
+            })
+            .on(MessageOpcode::CONSTRAINT_SET_IGNORED, [](GauloisSolver &s, Message *m) {
+                s.setConstraintIgnored(m);
+            })
+            .on(MessageOpcode::CONSTRAINTS_SET_IGNORED, [](GauloisSolver &s, Message *m) {
+                s.setConstraintsIgnored(m);
+            })
+            .on(MessageOpcode::CONSTRAINT_IS_IGNORED, [](GauloisSolver &s, Message *m) {
+                s.isConstraintIgnored(m);
+            })
+            .on(MessageOpcode::CONSTRAINTS_IS_IGNORED, [](GauloisSolver &s, Message *m) {
+                s.isConstraintsIgnored(m);
+            })
+            .on(MessageOpcode::CONSTRAINTS_SCORE, [](GauloisSolver &s, Message *m) {
+                s.getConstraintsScore(m);
+            })
+            .on(MessageOpcode::SUBSCRIBE_CONSTRAINTS_SCORE, [](GauloisSolver &s, Message *m) {
+                s.subscribeConstraintsScore(m);
+            });
+    return table;
+}
+
+void GauloisSolver::configure(Message *m) {
+    std::scoped_lock lock(loadMutex);
+    MessageReader reader(m);
+    auto n = reader.readUnsigned();
+    for (unsigned long long i = 0; i < n; i++) {
+        MessageHandle command(reader.readMessage());
+        command->src = m->src;
+        readMessage(command.get());
     }
 }
 
 std::vector<Universe::BigInteger> GauloisSolver::solution(Message *m) {
     boundMutex.lock();
     MessageBuilder mb;
-    mb.named(PANO_MESSAGE_SOLUTION);
-    for (auto &big: sol) {
-        mb.withParameter(Universe::toString(big));
-    }
-    Message *r = mb.withTag(PANO_TAG_RESPONSE).build();
-    comm->send(r, m->src);
-    free(r);
+    mb.withOpcode(MessageOpcode::SOLUTION);
+    writeSolution(mb);
+    Message *r = mb.inResponseTo(m).build();
+    comm->transfer(r, m->src);
     boundMutex.unlock();
     return sol;
 }
 
+void GauloisSolver::writeSolution(MessageBuilder &mb) {
+    mb.reserve(sol.size() * PANO_NUMBER_MAX_CHAR).withUnsigned(sol.size());
+    for (auto &big: sol) {
+        mb.withBigInteger(big);
+    }
+}
+
+void GauloisSolver::writeMapSolution(MessageBuilder &mb) {
+    std::scoped_lock lock(dictionaryMutex);
+    mb.reserve(currentSolution.size() * (PANO_VARIABLE_NAME_MAX_CHAR + PANO_NUMBER_MAX_CHAR))
+            .withUnsigned(currentSolution.size());
+    for (auto &kv: currentSolution) {
+        dictionary.writeVariable(mb, kv.first);
+        mb.withBigInteger(kv.second);
+    }
+}
+
+void GauloisSolver::sendVariableDictionary(Message *m) {
+    std::vector<std::string> names;
+    auto &mapping = solver->getVariablesMapping();
+    names.reserve(mapping.size());
+    for (auto &kv: mapping) {
+        names.push_back(kv.first);
+    }
+
+    // The dictionary is only used once it has been sent, so that both solvers agree on it.
+    std::scoped_lock lock(dictionaryMutex);
+    dictionary = VariableDictionary(std::move(names));
+    MessageBuilder mb;
+    mb.withOpcode(MessageOpcode::GET_VARIABLES_MAPPING);
+    dictionary.writeTo(mb);
+    comm->transfer(mb.inResponseTo(m).build(), m->src);
+}
+
+void GauloisSolver::forgetVariableDictionary() {
+    std::scoped_lock lock(dictionaryMutex);
+    dictionary = VariableDictionary();
+}
+
+void GauloisSolver::attachSolution(MessageBuilder &mb) {
+    if (solutionAttachmentLimit == 0) {
+        return;
+    }
+
+    // Looking for the values that have changed since the last attached solution.
+    std::vector<Universe::BigInteger> mapValues;
+    mapValues.reserve(currentSolution.size());
+    for (auto &kv: currentSolution) {
+        mapValues.push_back(kv.second);
+    }
+    bool hasBase = solutionDelta && (attachmentSequence > 0) &&
+                   (attachedSolution.size() == sol.size()) && (attachedMapValues.size() == mapValues.size());
+    std::vector<unsigned long> changedSolution;
+    std::vector<unsigned long> changedMap;
+    if (hasBase) {
+        for (unsigned long i = 0; i < sol.size(); i++) {
+            if (sol[i] != attachedSolution[i]) {
+                changedSolution.push_back(i);
+            }
+        }
+        for (unsigned long i = 0; i < mapValues.size(); i++) {
+            if (mapValues[i] != attachedMapValues[i]) {
+                changedMap.push_back(i);
+            }
+        }
+    }
+
+    unsigned long fullSize = sol.size() * PANO_NUMBER_MAX_CHAR +
+                             currentSolution.size() * (PANO_VARIABLE_NAME_MAX_CHAR + PANO_NUMBER_MAX_CHAR);
+    unsigned long deltaSize = (changedSolution.size() + changedMap.size()) * (sizeof(unsigned long) + PANO_NUMBER_MAX_CHAR);
+    bool delta = hasBase && (deltaSize < fullSize) && (deltaSize <= solutionAttachmentLimit);
+    if ((!delta) && (fullSize > solutionAttachmentLimit)) {
+        // The main solver will have to query the solution.
+        // The last attached solution remains the base of the next deltas.
+        return;
+    }
+
+    mb.withFlags(PANO_FLAG_SOLUTION).withUnsigned(attachmentSequence + 1);
+    if (delta) {
+        mb.withUnsigned(attachmentSequence)
+                .reserve(deltaSize)
+                .withUnsigned(changedSolution.size());
+        for (auto i: changedSolution) {
+            mb.withUnsigned(i).withBigInteger(sol[i]);
+        }
+        mb.withUnsigned(changedMap.size());
+        for (auto i: changedMap) {
+            mb.withUnsigned(i).withBigInteger(mapValues[i]);
+        }
+
+    } else {
+        mb.withUnsigned(0);
+        writeSolution(mb);
+        writeMapSolution(mb);
+    }
+
+    // The main solver receives the messages in order, so this solution is the base of the next delta.
+    attachmentSequence++;
+    if (solutionDelta) {
+        attachedSolution = sol;
+        attachedMapValues = std::move(mapValues);
+    }
+}
+
 int GauloisSolver::nVariables(Message *m) {
     int n = solver->nVariables();
     MessageBuilder mb;
-    Message *r = mb.named(PANO_MESSAGE_N_VARIABLES).withTag(PANO_TAG_RESPONSE).withParameter(n).build();
-    comm->send(r, m->src);
-    free(r);
+    Message *r = mb.withOpcode(MessageOpcode::N_VARIABLES).inResponseTo(m).withParameter(n).build();
+    comm->transfer(r, m->src);
     return n;
 }
 
 int GauloisSolver::nConstraints(Message *m) {
     int n = solver->nConstraints();
     MessageBuilder mb;
-    Message *r = mb.named(PANO_MESSAGE_N_CONSTRAINTS).withTag(PANO_TAG_RESPONSE).withParameter(n).build();
-    comm->send(r, m->src);
-    free(r);
+    Message *r = mb.withOpcode(MessageOpcode::N_CONSTRAINTS).inResponseTo(m).withParameter(n).build();
+    comm->transfer(r, m->src);
     return n;
 }
 
 Universe::UniverseSolverResult GauloisSolver::solve(Message *m) {
-    try {
-        int src = m->src;
-        std::thread t([this, src]() {
-            try {
-                LOG_F(INFO, "before load mutex");
-                loadMutex.lock();
-                LOG_F(INFO, "after load mutex");
-                auto result = this->solve();
-                LOG_F(INFO, "after solve");
-                sendResult(src, result);
-                LOG_F(INFO, "after send");
-                loadMutex.unlock();
-                finished.release();
-                easyjni::JavaVirtualMachineRegistry::detachCurrentThread();
-            } catch (std::exception &e) {
-                std::cerr << e.what() << std::endl;
-            }
+    int src = m->src;
+    executor.execute(comm->attach([this, src]() {
+        searchAndReport(src, [this]() {
+            return this->solve();
         });
-        t.detach();
+    }));
+    return Universe::UniverseSolverResult::UNKNOWN;
+}
+
+void GauloisSolver::searchAndReport(int src, const std::function<Universe::UniverseSolverResult()> &search) {
+    std::scoped_lock lock(loadMutex);
+    auto result = Universe::UniverseSolverResult::UNKNOWN;
+    try {
+        result = search();
     } catch (std::exception &e) {
-        std::cerr << e.what() << std::endl;
+        LOG_F(ERROR, "search failed: %s", e.what());
     }
-    return Universe::UniverseSolverResult::UNKNOWN;
+    sendResult(src, result);
 }
 
 void GauloisSolver::sendResult(int src, Universe::UniverseSolverResult result) {
@@ -328,27 +519,28 @@ void GauloisSolver::sendResult(int src, Universe::UniverseSolverResult result) {
         case Universe::UniverseSolverResult::SATISFIABLE:
             if (optimization) {
                 currentBound = getOptimSolver()->getCurrentBound();
-                mb.named(PANO_MESSAGE_NEW_BOUND_FOUND).withParameter(currentBound);
+                mb.withOpcode(MessageOpcode::NEW_BOUND_FOUND).withBigInteger(currentBound);
             } else {
-                mb.named(PANO_MESSAGE_SATISFIABLE);
+                mb.withOpcode(MessageOpcode::SATISFIABLE);
             }
             LOG_F(INFO, "map solution");
             currentSolution = solver->mapSolution();
             LOG_F(INFO, "solution");
             sol = solver->solution();
             LOG_F(INFO, "fini");
+            attachSolution(mb);
             break;
         case Universe::UniverseSolverResult::UNSATISFIABLE:
-            mb.named(PANO_MESSAGE_UNSATISFIABLE);
+            mb.withOpcode(MessageOpcode::UNSATISFIABLE);
             break;
         case Universe::UniverseSolverResult::UNKNOWN:
-            mb.named(PANO_MESSAGE_UNKNOWN);
+            mb.withOpcode(MessageOpcode::UNKNOWN);
             break;
         case Universe::UniverseSolverResult::UNSUPPORTED:
-            mb.named(PANO_MESSAGE_UNSUPPORTED);
+            mb.withOpcode(MessageOpcode::UNSUPPORTED);
             break;
         case Universe::UniverseSolverResult::OPTIMUM_FOUND:
-            mb.named(PANO_MESSAGE_OPTIMUM_FOUND);
+            mb.withOpcode(MessageOpcode::OPTIMUM_FOUND);
             break;
     }
     boundMutex.unlock();
@@ -356,61 +548,96 @@ void GauloisSolver::sendResult(int src, Universe::UniverseSolverResult result) {
     LOG_F(INFO, "#%d sending result to %d: %s", comm->getId(), src,
           result == Universe::UniverseSolverResult::SATISFIABLE ? "satisfiable" :
           result == Universe::UniverseSolverResult::UNSATISFIABLE ? "unsatisfiable" : "unknown");
-    comm->send(r, src);
-    free(r);
+    comm->transfer(r, src);
     LOG_F(INFO, "result sent");
 }
 
 Universe::UniverseSolverResult GauloisSolver::solve(std::string filename, Message *m) {
     int src = m->src;
-    std::thread t([this, src, filename]() {
-        loadMutex.lock();
-        auto result = this->solve(filename);
-        sendResult(src, result);
-        loadMutex.unlock();
-        finished.release();
-    });
-    t.detach();
+    forgetVariableDictionary();
+    executor.execute(comm->attach([this, src, filename]() {
+        searchAndReport(src, [this, &filename]() {
+            return this->solve(filename);
+        });
+    }));
     return Universe::UniverseSolverResult::UNKNOWN;
 }
 
 Universe::UniverseSolverResult
 GauloisSolver::solve(std::vector<Universe::UniverseAssumption<Universe::BigInteger>> asumpts, Message *m) {
     int src = m->src;
-    std::thread t([this, src, asumpts]() {
-        std::vector<Universe::UniverseAssumption<Universe::BigInteger>> realAssumpts;
-        for (int i = 0; i < asumpts.size(); i++) {
-            auto &a = asumpts[i];
-            if (a.isEqual()) {
-                realAssumpts.emplace_back(a);
-            }  else {
-                std::map<std::string, Universe::IUniverseVariable*> mapping = solver->getVariablesMapping();
-                auto &b = asumpts[i + 1];
-                mapping[a.getVariableId()]->getDomain()->keepValues(a.getValue(), b.getValue());
-                i++;
+    executor.execute(comm->attach([this, src, asumpts]() {
+        searchAndReport(src, [this, &asumpts]() {
+            std::vector<Universe::UniverseAssumption<Universe::BigInteger>> realAssumpts;
+            for (int i = 0; i < asumpts.size(); i++) {
+                auto &a = asumpts[i];
+                if (a.isEqual()) {
+                    realAssumpts.emplace_back(a);
+                }  else {
+                    std::map<std::string, Universe::IUniverseVariable*> mapping = solver->getVariablesMapping();
+                    auto &b = asumpts[i + 1];
+                    mapping[a.getVariableId()]->getDomain()->keepValues(a.getValue(), b.getValue());
+                    instanceModified = true;
+                    i++;
+                }
             }
-        }
 
-        LOG_F(INFO, "Run solve(assumpts,m) in a new thread.");
-        loadMutex.lock();
-        LOG_F(INFO, "après loadmutex.lock()");
-        auto result = this->solve(asumpts);
-        sendResult(src, result);
-        loadMutex.unlock();
-        easyjni::JavaVirtualMachineRegistry::detachCurrentThread();
-        finished.release();
-    });
-    t.detach();
+            LOG_F(INFO, "Run solve(assumpts,m) on the solving thread.");
+            return this->solve(asumpts);
+        });
+    }));
     return Universe::UniverseSolverResult::UNKNOWN;
 }
 
 void GauloisSolver::loadInstance(const std::string &filename) {
     loadMutex.lock();
+    forgetVariableDictionary();
     solver->loadInstance(filename);
+    instanceModified = false;
     optimization = solver->isOptimization();
     loadMutex.unlock();
 }
 
+void GauloisSolver::receiveInstance(Message *m) {
+    MessageReader reader(m);
+    auto name = filesystem::path(reader.readString()).filename().string();
+    unsigned int requestId = 0;
+    auto nbRecipients = reader.readUnsigned();
+    for (unsigned long long i = 0; i < nbRecipients; i++) {
+        auto rank = reader.readInteger();
+        auto id = (unsigned int) reader.readUnsigned();
+        if (rank == comm->getId()) {
+            requestId = id;
+        }
+    }
+    auto content = reader.readString();
+
+    // The name of the file is kept, as solvers may rely on its extension.
+    auto path = filesystem::temp_directory_path() /
+                ("panoramyx_" + to_string(getpid()) + "_" + to_string(comm->getId()) + "_" + name);
+    ofstream output(path, ios::binary);
+    output.write(content.data(), (streamsize) content.size());
+    output.close();
+    if (!output) {
+        throw Except::IllegalStateException("cannot write instance to " + path.string());
+    }
+    receivedInstance = path.string();
+    LOG_F(INFO, "received instance %s (%lu bytes)", receivedInstance.c_str(), content.size());
+
+    MessageBuilder mb;
+    mb.withOpcode(MessageOpcode::INSTANCE_DATA).inResponseTo(m).withRequestId(requestId);
+    comm->transfer(mb.build(), m->src);
+}
+
+void GauloisSolver::loadReceivedInstance() {
+    if (receivedInstance.empty()) {
+        throw Except::IllegalStateException("no instance has been received");
+    }
+    loadInstance(receivedInstance);
+    filesystem::remove(receivedInstance);
+    receivedInstance.clear();
+}
+
 const map<std::string, Universe::IUniverseVariable *> &GauloisSolver::getVariablesMapping() {
     return solver->getVariablesMapping();
 }
@@ -428,6 +655,7 @@ void GauloisSolver::setLowerBound(const Universe::BigInteger &lb) {
     boundMutex.lock();
     LOG_F(INFO, "New lower bound %lld", lb);
     this->getOptimSolver()->setLowerBound(lb);
+    instanceModified = true;
     boundMutex.unlock();
 }
 
@@ -436,12 +664,14 @@ void GauloisSolver::setUpperBound(const Universe::BigInteger &ub) {
     boundMutex.lock();
     LOG_F(INFO, "New upper bound %lld", ub);
     this->getOptimSolver()->setUpperBound(ub);
+    instanceModified = true;
     boundMutex.unlock();
 }
 
 void GauloisSolver::setBounds(const Universe::BigInteger &lb, const Universe::BigInteger &ub) {
     boundMutex.lock();
     this->getOptimSolver()->setBounds(lb, ub);
+    instanceModified = true;
     boundMutex.unlock();
 }
 
@@ -469,47 +699,62 @@ Universe::BigInteger GauloisSolver::getUpperBound() {
 Universe::BigInteger GauloisSolver::getLowerBound(Message *m) {
     auto result = this->getLowerBound();
     MessageBuilder mb;
-    Message *r = mb.named(PANO_MESSAGE_GET_LOWER_BOUND).withTag(PANO_TAG_RESPONSE).withParameter(result).build();
-    comm->send(r, m->src);
-    free(r);
+    Message *r = mb.withOpcode(MessageOpcode::GET_LOWER_BOUND).inResponseTo(m).withBigInteger(result).build();
+    comm->transfer(r, m->src);
     return result;
 }
 
 Universe::BigInteger GauloisSolver::getUpperBound(Message *m) {
     auto result = this->getUpperBound();
     MessageBuilder mb;
-    Message *r = mb.named(PANO_MESSAGE_GET_UPPER_BOUND).withTag(PANO_TAG_RESPONSE).withParameter(result).build();
-    comm->send(r, m->src);
-    free(r);
+    Message *r = mb.withOpcode(MessageOpcode::GET_UPPER_BOUND).inResponseTo(m).withBigInteger(result).build();
+    comm->transfer(r, m->src);
     return result;
 }
 
 Universe::BigInteger GauloisSolver::getCurrentBound(Message *m) {
     auto result = this->getCurrentBound();
     MessageBuilder mb;
-    Message *r = mb.named(PANO_MESSAGE_GET_CURRENT_BOUND).withTag(PANO_TAG_RESPONSE).withParameter(result).build();
-    comm->send(r, m->src);
-    free(r);
+    Message *r = mb.withOpcode(MessageOpcode::GET_CURRENT_BOUND).inResponseTo(m).withBigInteger(result).build();
+    comm->transfer(r, m->src);
     return result;
 }
 
 bool GauloisSolver::isMinimization(Message *m) {
     auto result = this->isMinimization();
     MessageBuilder mb;
-    Message *r = mb.named(PANO_MESSAGE_IS_MINIMIZATION).withTag(PANO_TAG_RESPONSE).withParameter(result).build();
-    comm->send(r, m->src);
-    free(r);
+    Message *r = mb.withOpcode(MessageOpcode::IS_MINIMIZATION).inResponseTo(m).withParameter(result).build();
+    comm->transfer(r, m->src);
     return result;
 }
 
+void GauloisSolver::getMetadata(Message *m) {
+    bool optim = isOptimization();
+    MessageBuilder mb;
+    mb.withOpcode(MessageOpcode::GET_METADATA)
+            .withParameter(solver->nVariables())
+            .withParameter(solver->nConstraints())
+            .withParameter(optim);
+    if (optim) {
+        mb.withParameter(isMinimization())
+                .withBigInteger(getLowerBound())
+                .withBigInteger(getUpperBound());
+    }
+    auto &auxiliaryVariables = solver->getAuxiliaryVariables();
+    mb.withUnsigned(auxiliaryVariables.size());
+    for (auto &name: auxiliaryVariables) {
+        mb.withString(name);
+    }
+    comm->transfer(mb.inResponseTo(m).build(), m->src);
+}
+
 bool GauloisSolver::isOptimization(Message *m) {
     MessageBuilder mb;
-    Message *r = mb.named(PANO_MESSAGE_IS_OPTIMIZATION).withTag(PANO_TAG_RESPONSE).withParameter(
+    Message *r = mb.withOpcode(MessageOpcode::IS_OPTIMIZATION).inResponseTo(m).withParameter(
             isOptimization()).build();
 
     LOG_F(INFO, "send message to %d", m->src);
-    comm->send(r, m->src);
-    free(r);
+    comm->transfer(r, m->src);
     return optimization;
 }
 
@@ -518,14 +763,10 @@ std::map<std::string, Universe::BigInteger> GauloisSolver::mapSolution(Message *
     boundMutex.lock();
     LOG_F(INFO, "log après");
     MessageBuilder mb;
-    mb.named(PANO_MESSAGE_MAP_SOLUTION);
-    for (auto &kv: currentSolution) {
-        mb.withParameter(kv.first);
-        mb.withParameter(kv.second);
-    }
-    Message *r = mb.withTag(PANO_TAG_RESPONSE).build();
-    comm->send(r, m->src);
-    free(r);
+    mb.withOpcode(MessageOpcode::MAP_SOLUTION);
+    writeMapSolution(mb);
+    Message *r = mb.inResponseTo(m).build();
+    comm->transfer(r, m->src);
     boundMutex.unlock();
 
     return currentSolution;
@@ -553,12 +794,11 @@ Universe::IOptimizationSolver *GauloisSolver::toOptimizationSolver() {
 
 void GauloisSolver::decisionVariables(Message *m) {
     std::vector<std::string> decisions;
-    for (int i = 0, n = 0; n < m->nbParameters; n += 1) {
-        int s = (int) strlen(m->parameters + i);
-        char *ptr = m->parameters + i;
-        std::string varId(ptr, s + 1);
-        i += s;
-        decisions.push_back(varId);
+    MessageReader reader(m);
+    auto n = reader.readUnsigned();
+    decisions.reserve(n);
+    for (unsigned long long i = 0; i < n; i++) {
+        decisions.emplace_back(reader.readString());
     }
     this->decisionVariables(decisions);
 }
@@ -586,13 +826,13 @@ bool GauloisSolver::checkSolution(const map<std::string, Universe::BigInteger> &
 
 void GauloisSolver::getAuxiliaryVariables(Message *pMessage) {
     MessageBuilder mb;
-    mb.named(PANO_MESSAGE_MAP_SOLUTION);
-    for (auto &kv: solver->getAuxiliaryVariables()) {
-        mb.withParameter(kv);
+    auto &auxiliaryVariables = solver->getAuxiliaryVariables();
+    mb.withOpcode(MessageOpcode::GET_AUXILIARY_VARIABLES).withUnsigned(auxiliaryVariables.size());
+    for (auto &name: auxiliaryVariables) {
+        mb.withString(name);
     }
-    Message *r = mb.withTag(PANO_TAG_RESPONSE).build();
-    comm->send(r, pMessage->src);
-    free(r);
+    Message *r = mb.inResponseTo(pMessage).build();
+    comm->transfer(r, pMessage->src);
 }
 
 const vector<Universe::IUniverseConstraint *> &GauloisSolver::getConstraints() {
@@ -602,55 +842,42 @@ const vector<Universe::IUniverseConstraint *> &GauloisSolver::getConstraints() {
 
 void GauloisSolver::checkSolutionAssignment(Message *pMessage) {
     std::map<std::string, Universe::BigInteger> bigbig;
-    char *ptrName = pMessage->parameters;
-    char *ptrValue = nullptr;
-    char *ptr = pMessage->parameters;
-    for (int i = 0, n = 0; n < pMessage->nbParameters; i++) {
-        if (ptr[i] == '\0') {
-            if (ptrValue == nullptr) {
-                ptrValue = ptr + i + 1;
-            } else {
-                std::string name(ptrName, ptrValue - ptrName - 1);
-                std::string value(ptrValue, ptr + i - ptrValue);
-                bigbig[name] = Universe::bigIntegerValueOf(value);
-                ptrValue = nullptr;
-                ptrName = ptr + i + 1;
-            }
-            n++;
+    MessageReader reader(pMessage);
+    {
+        std::scoped_lock lock(dictionaryMutex);
+        auto n = reader.readUnsigned();
+        for (unsigned long long i = 0; i < n; i++) {
+            auto name = dictionary.readVariable(reader);
+            bigbig[name] = reader.readBigInteger();
         }
     }
     bool b = solver->checkSolution(bigbig);
     MessageBuilder mb;
-    Message *r = mb.named(PANO_MESSAGE_CHECK_SOLUTION_ASSIGNMENT).withTag(PANO_TAG_RESPONSE).withParameter(b).build();
-    comm->send(r, pMessage->src);
-    free(r);
+    Message *r = mb.withOpcode(MessageOpcode::CHECK_SOLUTION_ASSIGNMENT).inResponseTo(pMessage).withParameter(b).build();
+    comm->transfer(r, pMessage->src);
 
 }
 
 void GauloisSolver::checkSolution(Message *pMessage) {
     bool b = solver->checkSolution();
     MessageBuilder mb;
-    Message *r = mb.named(PANO_MESSAGE_CHECK_SOLUTION).withTag(PANO_TAG_RESPONSE).withParameter(b).build();
-    comm->send(r, pMessage->src);
-    free(r);
+    Message *r = mb.withOpcode(MessageOpcode::CHECK_SOLUTION).inResponseTo(pMessage).withParameter(b).build();
+    comm->transfer(r, pMessage->src);
 }
 
 void GauloisSolver::valueHeuristicStatic(Message *pMessage) {
     std::vector<std::string> names;
     std::vector<Universe::BigInteger> ordered;
-    int n = pMessage->read<int>();
-    char *ptrName = pMessage->parameters + sizeof(int);
-    for (int i = 0; i < n; i++) {
-        std::string name(ptrName, strlen(ptrName) + 1);
-        names.push_back(name);
-        ptrName += name.size() + 1;
+    MessageReader reader(pMessage);
+    auto n = reader.readUnsigned();
+    names.reserve(n);
+    for (unsigned long long i = 0; i < n; i++) {
+        names.emplace_back(reader.readString());
     }
-    n = *((int *) ptrName);
-    ptrName = ptrName + sizeof(int);
-    for (int i = 0; i < n; i++) {
-        std::string big(ptrName, strlen(ptrName) + 1);
-        ordered.push_back(Universe::bigIntegerValueOf(big));
-        ptrName += big.size() + 1;
+    n = reader.readUnsigned();
+    ordered.reserve(n);
+    for (unsigned long long i = 0; i < n; i++) {
+        ordered.push_back(reader.readBigInteger());
     }
     this->valueHeuristicStatic(names, ordered);
 }
@@ -661,13 +888,103 @@ void GauloisSolver::setConstraintIgnored(Panoramyx::Message *m) {
     getConstraints()[index]->setIgnored(ignored);
 }
 
+void GauloisSolver::setConstraintsIgnored(Panoramyx::Message *m) {
+    auto &constraints = getConstraints();
+    MessageReader reader(m);
+    bool ignored = reader.read<bool>();
+    auto nbRuns = reader.readUnsigned();
+    unsigned long index = 0;
+    for (unsigned long long run = 0; run < nbRuns; run++) {
+        auto end = index + reader.readUnsigned();
+        if (end > constraints.size()) {
+            throw Except::IllegalArgumentException("more constraints than in the solver");
+        }
+        for (; index < end; index++) {
+            constraints[index]->setIgnored(ignored);
+        }
+        ignored = !ignored;
+    }
+}
+
+void GauloisSolver::isConstraintsIgnored(Panoramyx::Message *m) {
+    MessageReader reader(m);
+    auto indices = reader.readIndices();
+    auto &constraints = getConstraints();
+    MessageBuilder mb;
+    mb.withOpcode(MessageOpcode::CONSTRAINTS_IS_IGNORED).withUnsigned(indices.size());
+    unsigned char bits = 0;
+    for (unsigned long i = 0; i < indices.size(); i++) {
+        if (constraints.at(indices[i])->isIgnored()) {
+            bits |= (unsigned char) (1 << (i % 8));
+        }
+        if (((i % 8) == 7) || (i == indices.size() - 1)) {
+            mb.withParameter(bits);
+            bits = 0;
+        }
+    }
+    comm->transfer(mb.inResponseTo(m).build(), m->src);
+}
+
+void GauloisSolver::getConstraintsScore(Panoramyx::Message *m) {
+    MessageReader reader(m);
+    auto indices = reader.readIndices();
+    MessageBuilder mb;
+    mb.withOpcode(MessageOpcode::CONSTRAINTS_SCORE);
+    writeConstraintsScore(mb, indices);
+    comm->transfer(mb.inResponseTo(m).build(), m->src);
+}
+
+void GauloisSolver::writeConstraintsScore(MessageBuilder &mb, const std::vector<int> &indices) {
+    auto &constraints = getConstraints();
+    mb.reserve(indices.size() * sizeof(double)).withUnsigned(indices.size());
+    for (auto i: indices) {
+        mb.withParameter((double) constraints.at(i)->getScore());
+    }
+}
+
+void GauloisSolver::subscribeConstraintsScore(Panoramyx::Message *m) {
+    MessageReader reader(m);
+    auto period = reader.readInteger();
+    auto indices = reader.readIndices();
+    unsubscribeConstraintsScore();
+    if (period <= 0) {
+        return;
+    }
+
+    int src = m->src;
+    scoresSubscribed = true;
+    scoresThread = std::thread(comm->attach([this, src, period, indices]() {
+        std::unique_lock lock(scoresMutex);
+        while (!scoresCondition.wait_for(lock, std::chrono::milliseconds(period), [this]() {
+            return !scoresSubscribed;
+        })) {
+            // The snapshots are handled by the main solver as the results of the search.
+            MessageBuilder mb;
+            mb.withOpcode(MessageOpcode::CONSTRAINTS_SCORE).withParameter(index);
+            writeConstraintsScore(mb, indices);
+            comm->transfer(mb.withTag(PANO_TAG_SOLVE).build(), src);
+        }
+        easyjni::JavaVirtualMachineRegistry::detachCurrentThread();
+    }));
+}
+
+void GauloisSolver::unsubscribeConstraintsScore() {
+    {
+        std::scoped_lock lock(scoresMutex);
+        scoresSubscribed = false;
+    }
+    scoresCondition.notify_all();
+    if (scoresThread.joinable()) {
+        scoresThread.join();
+    }
+}
+
 bool GauloisSolver::isConstraintIgnored(Panoramyx::Message *m) {
     int index = m->read<int>();
     bool ignored = getConstraints()[index]->isIgnored();
     MessageBuilder mb;
-    Message *r = mb.named(PANO_MESSAGE_CONSTRAINT_IS_IGNORED).withTag(PANO_TAG_RESPONSE).withParameter(ignored).build();
-    comm->send(r, m->src);
-    free(r);
+    Message *r = mb.withOpcode(MessageOpcode::CONSTRAINT_IS_IGNORED).inResponseTo(m).withParameter(ignored).build();
+    comm->transfer(r, m->src);
     return ignored;
 }
 
@@ -675,8 +992,7 @@ double GauloisSolver::getConstraintScore(Panoramyx::Message *m) {
     int index = m->read<int>();
     double score = getConstraints()[index]->getScore();
     MessageBuilder mb;
-    Message *r = mb.named(PANO_MESSAGE_CONSTRAINT_IS_IGNORED).withTag(PANO_TAG_RESPONSE).withParameter(score).build();
-    comm->send(r, m->src);
-    free(r);
+    Message *r = mb.withOpcode(MessageOpcode::CONSTRAINT_IS_IGNORED).inResponseTo(m).withParameter(score).build();
+    comm->transfer(r, m->src);
     return score;
 }
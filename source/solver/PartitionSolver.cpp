@@ -38,6 +38,7 @@
 #include <crillab-panoramyx/decomposition/HypergraphDecompositionCubeGenerator.hpp>
 #include <crillab-panoramyx/solver/PartitionSolver.hpp>
 #include <crillab-panoramyx/network/MessageBuilder.hpp>
+#include <crillab-panoramyx/network/MessagePool.hpp>
 
 using namespace std;
 
@@ -71,35 +72,20 @@ void PartitionSolver::beforeSearch() {
 
 void PartitionSolver::beforeSearch(unsigned int solverIndex) {
     // Ignoring constraints that are not in the partition assigned to the solver.
+    // All the constraints are set at once, so that a single message is sent to the solver.
     auto *solver = solvers[solverIndex];
-    auto &constraints = solver->getConstraints();
-    auto &solverPartition = constraintsInPartitions[solverIndex];
-
-    if (solverPartition.empty()) {
-        // All constraints are ignored as the partition is empty.
-        for (auto * constraint : constraints) {
-            constraint->setIgnored(true);
-        }
-
-    } else {
-        for (int current = 0, i = 0; i < constraints.size(); i++) {
-            if ((current < solverPartition.size()) && (i == solverPartition[current])) {
-                // This constraint is in the partition, so it must be kept.
-                constraints[i]->setIgnored(false);
-                current++;
-
-            } else {
-                // The constraint is not in the partition, so it is ignored.
-                constraints[i]->setIgnored(true);
-            }
-        }
+    std::vector<bool> ignored(solver->nConstraints(), true);
+    for (auto i : constraintsInPartitions[solverIndex]) {
+        // This constraint is in the partition, so it must be kept.
+        ignored[i] = false;
     }
+    solver->setIgnoredConstraints(ignored);
 
     // TODO Should we restrict variables in the solver? Maybe with decisionVariables()?
 }
 
 void PartitionSolver::startSearch() {
-    std::thread solvingThread([this]() {
+    std::thread solvingThread(communicator->attach([this]() {
         // Generating the cubes, and assigning them to the different solvers.
         for (auto cube : *this->generator->generateCubes()) {
             if (cube.empty()) {
@@ -127,7 +113,7 @@ void PartitionSolver::startSearch() {
                 break;
             }
         }
-    });
+    }));
 
     solvingThread.detach();
 }
@@ -187,6 +173,7 @@ void PartitionSolver::onUnsatisfiableFound(unsigned) {
     for (auto *solver : solvers) {
         solver->interrupt();
     }
+    flushSolvers();
 
     // The solver has finished its sub-problem.
     partitions.release();
@@ -229,9 +216,8 @@ void PartitionSolver::readEnd(const Panoramyx::Message *message) {
     AbstractParallelSolver::readEnd(message);
     if (runningSolvers <= 0) {
         MessageBuilder mb;
-        Message *r = mb.named(PANO_MESSAGE_END_SEARCH_ACK).withTag(PANO_TAG_SOLVE).build();
-        communicator->send(r, 0);
-        free(r);
+        Message *r = mb.withOpcode(MessageOpcode::END_SEARCH_ACK).withTag(PANO_TAG_SOLVE).build();
+        communicator->transfer(r, 0);
     }
 }
 
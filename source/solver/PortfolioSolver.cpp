@@ -49,19 +49,20 @@ PortfolioSolver::PortfolioSolver(INetworkCommunication *comm, IBoundAllocationSt
 void PortfolioSolver::beforeSearch() {
     if (isOptimization()) {
         // FIXME: Maybe use a state design pattern here?
-        minimization = solvers[0]->isMinimization();
+        // The three values are read from the same snapshot of the solver metadata.
+        auto isMinimization = solvers[0]->isMinimizationAsync();
+        auto lb = solvers[0]->getLowerBoundAsync();
+        auto ub = solvers[0]->getUpperBoundAsync();
+        minimization = isMinimization.get();
         allocationStrategy->setMinimization(minimization);
-        lowerBound = solvers[0]->getLowerBound();
-        upperBound = solvers[0]->getUpperBound();
+        lowerBound = lb.get();
+        upperBound = ub.get();
         currentBounds = allocationStrategy->computeBoundAllocation(currentBounds, lowerBound, upperBound);
     }
 }
 
 void PortfolioSolver::startSearch() {
     for (unsigned i = 0; i < solvers.size(); i++) {
-        // FIXME: Avoid invoking nVariables() and nConstraints() like this...
-        solvers[i]->nVariables();
-        solvers[i]->nConstraints();
         solve(i);
         currentRunningSolvers[i] = true;
     }
@@ -69,9 +70,6 @@ void PortfolioSolver::startSearch() {
 
 void PortfolioSolver::startSearch(const vector<UniverseAssumption<BigInteger>> &assumpts) {
     for (unsigned i = 0; i < solvers.size(); i++) {
-        // FIXME: Avoid invoking nVariables() and nConstraints() like this...
-        solvers[i]->nVariables();
-        solvers[i]->nConstraints();
         solve(i, assumpts);
         currentRunningSolvers[i] = true;
     }
@@ -198,11 +196,12 @@ void PortfolioSolver::updateBounds() {
         LOG_F(INFO, "solver #%lu %s running", i, (currentRunningSolvers[i] ? "is": "is not"));
         if (!currentRunningSolvers[i]) {
             // The solver must be restarted with its newly allocated bound.
-            solver->reset();
+            restart(solver);
             solver->solve();
             currentRunningSolvers[i] = true;
         }
     }
+    flushSolvers();
 }
 
 void PortfolioSolver::assignBounds(unsigned index) {
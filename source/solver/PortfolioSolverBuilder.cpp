@@ -40,5 +40,7 @@ PortfolioSolverBuilder *PortfolioSolverBuilder::withAllocationStrategy(IBoundAll
 }
 
 AbstractParallelSolver *PortfolioSolverBuilder::build() {
-    return new PortfolioSolver(networkCommunication, allocationStrategy);
+    auto *solver = new PortfolioSolver(networkCommunication, allocationStrategy);
+    solver->setInstanceBroadcast(instanceBroadcast);
+    return solver;
 }
@@ -35,211 +35,439 @@
 
 #include <crillab-panoramyx/network/Message.hpp>
 #include <crillab-panoramyx/network/MessageBuilder.hpp>
+#include <crillab-panoramyx/network/MessageHandle.hpp>
+#include <crillab-panoramyx/network/MessagePool.hpp>
+#include <crillab-panoramyx/network/MessageReader.hpp>
 #include <crillab-panoramyx/solver/RemoteSolver.hpp>
-#include "crillab-panoramyx/problem/RemoteConstraint.hpp"
 
 using namespace Panoramyx;
 using namespace Universe;
 
 RemoteSolver::RemoteSolver(int rank) :
-        rank(rank) {
+        rank(rank),
+        responses(rank),
+        epoch(0),
+        metadataEpoch(0),
+        pendingEpoch(0),
+        baseSequence(0) {
     // Nothing to do: everything is already initialized.
 }
 
+RemoteSolver::~RemoteSolver() {
+    waitPosted();
+    for (auto *command : pendingConfiguration) {
+        MessagePool::release(command);
+    }
+}
+
+void RemoteSolver::configure(Message *message) {
+    std::scoped_lock lock(configurationMutex);
+    pendingConfiguration.push_back(message);
+}
+
+void RemoteSolver::sendConfiguration() {
+    std::scoped_lock lock(configurationMutex);
+    if (pendingConfiguration.empty()) {
+        return;
+    }
+
+    if (pendingConfiguration.size() == 1) {
+        // There is no need for an envelope.
+        communicator->transfer(pendingConfiguration[0], rank);
+
+    } else {
+        MessageBuilder mb;
+        mb.withOpcode(MessageOpcode::CONFIGURE).withUnsigned(pendingConfiguration.size());
+        for (auto *command : pendingConfiguration) {
+            mb.withMessage(command);
+            MessagePool::release(command);
+        }
+        communicator->transfer(mb.withTag(PANO_TAG_SOLVE).build(), rank);
+    }
+    pendingConfiguration.clear();
+}
+
+void RemoteSolver::send(Message *message) {
+    sendConfiguration();
+    communicator->transfer(message, rank);
+}
+
+void RemoteSolver::post(Message *message) {
+    sendConfiguration();
+    auto *request = communicator->isend(message, rank);
+    std::scoped_lock lock(pendingMutex);
+
+    // Forgetting the requests that have already completed.
+    std::erase_if(pendingRequests, [](INetworkRequest *pending) {
+        if (pending->test()) {
+            delete pending;
+            return true;
+        }
+        return false;
+    });
+    pendingRequests.push_back(request);
+}
+
+void RemoteSolver::flush() {
+    sendConfiguration();
+    waitPosted();
+}
+
+void RemoteSolver::waitPosted() {
+    std::scoped_lock lock(pendingMutex);
+    if (pendingRequests.empty()) {
+        return;
+    }
+
+    communicator->waitAll(pendingRequests);
+    for (auto *request : pendingRequests) {
+        delete request;
+    }
+    pendingRequests.clear();
+}
+
+unsigned int RemoteSolver::request(MessageBuilder &builder) {
+    unsigned int requestId = responses.newRequestId();
+    send(builder.withTag(PANO_TAG_RESPONSE).withRequestId(requestId).build());
+    return requestId;
+}
+
+void RemoteSolver::invalidateMetadata() {
+    epoch++;
+}
+
+std::shared_future<RemoteSolver::Metadata> RemoteSolver::metadataAsync() {
+    std::scoped_lock lock(metadataMutex);
+    unsigned long current = epoch;
+    if (metadata && (metadataEpoch == current)) {
+        return ready(*metadata).share();
+    }
+    if (pendingMetadata.valid() && (pendingEpoch == current)) {
+        return pendingMetadata;
+    }
+
+    MessageBuilder mb;
+    mb.withOpcode(MessageOpcode::GET_METADATA);
+    pendingEpoch = current;
+    pendingMetadata = query<Metadata>(mb, [this, current](const Message *response) {
+        Metadata snapshot;
+        MessageReader reader(response);
+        snapshot.nbVariables = reader.read<int>();
+        snapshot.nbConstraints = reader.read<int>();
+        snapshot.optimization = reader.read<bool>();
+        snapshot.minimization = false;
+        if (snapshot.optimization) {
+            snapshot.minimization = reader.read<bool>();
+            snapshot.lowerBound = reader.readBigInteger();
+            snapshot.upperBound = reader.readBigInteger();
+        }
+        auto n = reader.readUnsigned();
+        snapshot.auxiliaryVariables.reserve(n);
+        for (unsigned long long i = 0; i < n; i++) {
+            snapshot.auxiliaryVariables.emplace_back(reader.readString());
+        }
+
+        // A snapshot received late must not replace a more recent one.
+        std::scoped_lock lock(metadataMutex);
+        if ((!metadata) || (metadataEpoch <= current)) {
+            metadata = snapshot;
+            metadataEpoch = current;
+        }
+        return snapshot;
+    }).share();
+    return pendingMetadata;
+}
+
 void RemoteSolver::setIndex(unsigned i) {
     this->index = i;
     MessageBuilder mb;
-    mb.named(PANO_MESSAGE_INDEX);
+    mb.withOpcode(MessageOpcode::INDEX);
     Message *m = mb.withTag(PANO_TAG_SOLVE).withParameter(i).build();
-    communicator->send(m, rank);
-    free(m);
+    configure(m);
 }
 
 bool RemoteSolver::isOptimization() {
-    if (!optimization) {
-        mutex.lock();
-        MessageBuilder mb;
-        mb.named(PANO_MESSAGE_IS_OPTIMIZATION);
-        Message *m = mb.withTag(PANO_TAG_RESPONSE).build();
-        communicator->send(m, rank);
-        free(m);
-        LOG_F(INFO, "Wait answer");
-        m = communicator->receive(PANO_TAG_RESPONSE, rank, PANO_DEFAULT_MESSAGE_SIZE);
-        LOG_F(INFO, "after answer");
-        mutex.unlock();
-        optimization = m->read<bool>();
-        LOG_F(INFO, "Remote Solver: readMessage - %d", *optimization);
-        free(m);
-    }
-    return *optimization;
+    return metadataAsync().get().optimization;
+}
+
+std::future<bool> RemoteSolver::isOptimizationAsync() {
+    return fromMetadata<bool>([](const Metadata &snapshot) {
+        return snapshot.optimization;
+    });
 }
 
 UniverseSolverResult RemoteSolver::solve() {
-    nVariables();
-    nConstraints();
+    invalidateMetadata();
+    forgetAttachedSolution();
     MessageBuilder mb;
-    Message *m = mb.named(PANO_MESSAGE_SOLVE).withTag(PANO_TAG_SOLVE).build();
-    communicator->send(m, rank);
-    free(m);
+    Message *m = mb.withOpcode(MessageOpcode::SOLVE).withTag(PANO_TAG_SOLVE).build();
+    send(m);
     return UniverseSolverResult::UNKNOWN;
 }
 
 UniverseSolverResult RemoteSolver::solve(
         const std::string &filename) {
-    //todo nVariables ? nConstraints ? in this case
+    invalidateMetadata();
+    forgetAttachedSolution();
+    forgetVariableDictionary();
+    forgetCapabilities();
     MessageBuilder mb;
-    Message *m = mb.named(PANO_MESSAGE_SOLVE_FILENAME)
-            .withParameter(filename)
+    Message *m = mb.withOpcode(MessageOpcode::SOLVE_FILENAME)
+            .withString(filename)
             .withTag(PANO_TAG_SOLVE)
             .build();
-    communicator->send(m, rank);
-    free(m);
+    send(m);
     return UniverseSolverResult::UNKNOWN;
 }
 
 UniverseSolverResult RemoteSolver::solve(
         const std::vector<UniverseAssumption<BigInteger>>
         &assumpts) {
-    LOG_F(INFO, "#%d loading variables", rank);
-    nVariables();
-    LOG_F(INFO, "#%d loading constraints", rank);
-    nConstraints();
-    LOG_F(INFO, "loading done");
+    invalidateMetadata();
+    forgetAttachedSolution();
+    auto variables = variableDictionary();
     MessageBuilder mb;
-    mb.named(PANO_MESSAGE_SOLVE_ASSUMPTIONS);
+    mb.withOpcode(MessageOpcode::SOLVE_ASSUMPTIONS)
+            .reserve(assumpts.size() * (sizeof(unsigned long) + PANO_NUMBER_MAX_CHAR))
+            .withUnsigned(assumpts.size());
     for (auto &assumpt: assumpts) {
-        mb.withParameter(assumpt.getVariableId());
+        variables.get().writeVariable(mb, assumpt.getVariableId());
         mb.withParameter(assumpt.isEqual());
-        mb.withParameter(toString(assumpt.getValue()));
+        mb.withBigInteger(assumpt.getValue());
         LOG_F(INFO, "add assumption: %d %s %s '%s'",assumpt.getVariableId().size(), assumpt.getVariableId().c_str(),
               assumpt.isEqual() ? "=" : "!=",
               toString(assumpt.getValue()).c_str());
     }
     Message *m = mb.withTag(PANO_TAG_SOLVE).build();
-    communicator->send(m, rank);
-    free(m);
+    send(m);
     return UniverseSolverResult::UNKNOWN;
 }
 
 void RemoteSolver::interrupt() {
     MessageBuilder mb;
-    mb.named(PANO_MESSAGE_INTERRUPT);
-    Message *m = mb.withTag(PANO_TAG_SOLVE).build();
-    communicator->send(m, rank);
-    free(m);
+    mb.withOpcode(MessageOpcode::INTERRUPT);
+    post(mb.withTag(PANO_TAG_SOLVE).build());
 }
 
 void RemoteSolver::setVerbosity(int level) {
     MessageBuilder mb;
-    mb.named(PANO_MESSAGE_SET_VERBOSITY);
+    mb.withOpcode(MessageOpcode::SET_VERBOSITY);
     mb.withParameter(level);
     Message *m = mb.withTag(PANO_TAG_CONFIG).build();
-    communicator->send(m, rank);
-    free(m);
+    configure(m);
 }
 
 void RemoteSolver::setTimeout(long seconds) {
     MessageBuilder mb;
-    mb.named(PANO_MESSAGE_SET_TIMEOUT);
+    mb.withOpcode(MessageOpcode::SET_TIMEOUT);
     mb.withParameter(seconds);
     Message *m = mb.withTag(PANO_TAG_CONFIG).build();
-    communicator->send(m, rank);
-    free(m);
+    configure(m);
 }
 
 void RemoteSolver::setTimeoutMs(long mseconds) {
     MessageBuilder mb;
-    mb.named(PANO_MESSAGE_SET_TIMEOUT_MS);
+    mb.withOpcode(MessageOpcode::SET_TIMEOUT_MS);
     mb.withParameter(mseconds);
     Message *m = mb.withTag(PANO_TAG_CONFIG).build();
-    communicator->send(m, rank);
-    free(m);
+    configure(m);
 }
 
 void RemoteSolver::reset() {
+    invalidateMetadata();
+    forgetAttachedSolution();
     MessageBuilder mb;
-    mb.named(PANO_MESSAGE_RESET);
+    mb.withOpcode(MessageOpcode::RESET);
     Message *m = mb.withTag(PANO_TAG_SOLVE).build();
-    communicator->send(m, rank);
-    free(m);
+    configure(m);
+}
+
+unsigned RemoteSolver::getCapabilities() {
+    std::shared_future<unsigned> current;
+    {
+        std::scoped_lock lock(capabilitiesMutex);
+        if (!capabilities.valid()) {
+            MessageBuilder mb;
+            mb.withOpcode(MessageOpcode::GET_CAPABILITIES);
+            capabilities = query<unsigned>(mb, [](const Message *response) {
+                MessageReader reader(response);
+                return (unsigned) reader.readUnsigned();
+            }).share();
+        }
+        current = capabilities;
+    }
+    return current.get();
+}
+
+void RemoteSolver::forgetCapabilities() {
+    std::scoped_lock lock(capabilitiesMutex);
+    capabilities = std::shared_future<unsigned>();
+}
+
+void RemoteSolver::restore() {
+    invalidateMetadata();
+    forgetAttachedSolution();
+    MessageBuilder mb;
+    mb.withOpcode(MessageOpcode::RESTORE);
+    configure(mb.withTag(PANO_TAG_SOLVE).build());
 }
 
 std::vector<BigInteger> RemoteSolver::solution() {
-    unsigned long size =
-            nVariables() * (PANO_NUMBER_MAX_CHAR + 1) + sizeof(Message);
-    mutex.lock();
+    return solutionAsync().get();
+}
+
+std::future<std::vector<BigInteger>> RemoteSolver::solutionAsync() {
+    {
+        std::scoped_lock lock(attachedSolutionMutex);
+        if (attachedSolution) {
+            return ready(*attachedSolution);
+        }
+    }
+
     MessageBuilder mb;
-    mb.named(PANO_MESSAGE_SOLUTION);
-    Message *m = mb.withTag(PANO_TAG_RESPONSE).build();
-    communicator->send(m, rank);
-    free(m);
-    m = communicator->receive(PANO_TAG_RESPONSE, rank, size);
-    mutex.unlock();
+    mb.withOpcode(MessageOpcode::SOLUTION);
+    return query<std::vector<BigInteger>>(mb, [](const Message *response) {
+        MessageReader reader(response);
+        return readSolution(reader);
+    });
+}
 
+std::vector<BigInteger> RemoteSolver::readSolution(MessageReader &reader) {
     std::vector<BigInteger> bigbig;
-    char *ptr = m->parameters;
-    for (int i = 0, n = 0; n < m->nbParameters; i++) {
-        if (ptr[i] == '\0') {
-            std::string param(ptr, i);
-            bigbig.push_back(bigIntegerValueOf(param));
-            ptr += i + 1;
-            i = -1;
-            n++;
-        }
+    auto n = reader.readUnsigned();
+    bigbig.reserve(n);
+    for (unsigned long long i = 0; i < n; i++) {
+        bigbig.push_back(reader.readBigInteger());
     }
-    free(m);
     return bigbig;
 }
 
-int RemoteSolver::nVariables() {
-    if (nbVariables < 0) {
-        mutex.lock();
-        MessageBuilder mb;
-        mb.named(PANO_MESSAGE_N_VARIABLES);
-        Message *m = mb.withTag(PANO_TAG_RESPONSE).build();
-        communicator->send(m, rank);
-        free(m);
-
-        m = communicator->receive(PANO_TAG_RESPONSE, rank, PANO_DEFAULT_MESSAGE_SIZE);
-        mutex.unlock();
-        nbVariables = *((const int *) m->parameters);
-        free(m);
+std::map<std::string, BigInteger> RemoteSolver::readMapSolution(MessageReader &reader,
+                                                                 const VariableDictionary &variables) {
+    std::map<std::string, BigInteger> bigbig;
+    auto n = reader.readUnsigned();
+    for (unsigned long long i = 0; i < n; i++) {
+        auto name = variables.readVariable(reader);
+        bigbig[name] = reader.readBigInteger();
     }
-    return nbVariables;
+    return bigbig;
 }
 
-int RemoteSolver::nConstraints() {
-    if (nbConstraints < 0) {
-        mutex.lock();
-        MessageBuilder mb;
-        mb.named(PANO_MESSAGE_N_CONSTRAINTS);
-        Message *m = mb.withTag(PANO_TAG_RESPONSE).build();
-        communicator->send(m, rank);
-        free(m);
+void RemoteSolver::requestVariableDictionary() {
+    MessageBuilder mb;
+    mb.withOpcode(MessageOpcode::GET_VARIABLES_MAPPING);
+    auto requested = query<VariableDictionary>(mb, [](const Message *response) {
+        MessageReader reader(response);
+        return VariableDictionary::readFrom(reader);
+    }).share();
+    std::scoped_lock lock(dictionaryMutex);
+    dictionary = requested;
+}
 
-        m = communicator->receive(PANO_TAG_RESPONSE, rank);
-        mutex.unlock();
-        nbConstraints = *((const int *) m->parameters);
+void RemoteSolver::forgetVariableDictionary() {
+    std::scoped_lock lock(dictionaryMutex);
+    dictionary = std::shared_future<VariableDictionary>();
+}
 
-        for (int i = 0; i < nbConstraints; i++) {
-            remoteConstraints.push_back(new RemoteConstraint(communicator, mutex, rank, i));
+std::shared_future<VariableDictionary> RemoteSolver::variableDictionary() {
+    std::scoped_lock lock(dictionaryMutex);
+    if (dictionary.valid()) {
+        return dictionary;
+    }
+    return ready(VariableDictionary()).share();
+}
+
+void RemoteSolver::readAttachedSolution(MessageReader &reader) {
+    auto sequence = reader.readUnsigned();
+    auto base = reader.readUnsigned();
+    auto variables = variableDictionary();
+    std::scoped_lock lock(attachedSolutionMutex);
+
+    if (base == 0) {
+        // The full solution has been attached.
+        baseSolution = readSolution(reader);
+        baseMapSolution = readMapSolution(reader, variables.get());
+
+    } else if (base == baseSequence) {
+        // Only the values that have changed have been attached, in increasing order of their index.
+        auto n = reader.readUnsigned();
+        for (unsigned long long i = 0; i < n; i++) {
+            auto index = reader.readUnsigned();
+            if (index >= baseSolution.size()) {
+                invalidAttachedSolution();
+                return;
+            }
+            baseSolution[index] = reader.readBigInteger();
         }
-        free(m);
+        n = reader.readUnsigned();
+        auto it = baseMapSolution.begin();
+        unsigned long long position = 0;
+        for (unsigned long long i = 0; i < n; i++) {
+            auto index = reader.readUnsigned();
+            if ((index < position) || (index >= baseMapSolution.size())) {
+                invalidAttachedSolution();
+                return;
+            }
+            std::advance(it, index - position);
+            position = index;
+            it->second = reader.readBigInteger();
+        }
+
+    } else {
+        // This should not happen, as messages are received in order: the solution will be queried.
+        LOG_F(WARNING, "solver #%d sent a delta of solution #%llu, but solution #%llu was received",
+              rank, base, baseSequence);
+        attachedSolution.reset();
+        attachedMapSolution.reset();
+        return;
     }
-    return nbConstraints;
+
+    baseSequence = sequence;
+    attachedSolution = baseSolution;
+    attachedMapSolution = baseMapSolution;
+}
+
+void RemoteSolver::invalidAttachedSolution() {
+    LOG_F(ERROR, "solver #%d sent an invalid delta of solution, which will be queried", rank);
+
+    // The base solution has been partially updated, so no delta can be applied to it anymore.
+    baseSequence = 0;
+    attachedSolution.reset();
+    attachedMapSolution.reset();
+}
+
+void RemoteSolver::forgetAttachedSolution() {
+    std::scoped_lock lock(attachedSolutionMutex);
+    attachedSolution.reset();
+    attachedMapSolution.reset();
+}
+
+int RemoteSolver::nVariables() {
+    return metadataAsync().get().nbVariables;
+}
+
+std::future<int> RemoteSolver::nVariablesAsync() {
+    return fromMetadata<int>([](const Metadata &snapshot) {
+        return snapshot.nbVariables;
+    });
+}
+
+int RemoteSolver::nConstraints() {
+    return metadataAsync().get().nbConstraints;
 }
 
 void RemoteSolver::setLogFile(const std::string &filename) {}
 
 
-void RemoteSolver::setCommunicator(INetworkCommunication *communicator) { this->communicator = communicator; }
+void RemoteSolver::setCommunicator(INetworkCommunication *communicator) {
+    this->communicator = communicator;
+    responses.setCommunicator(communicator);
+}
 
 void RemoteSolver::endSearch() {
     MessageBuilder mb;
-    mb.named(PANO_MESSAGE_END_SEARCH);
-    Message *m = mb.withTag(PANO_TAG_SOLVE).build();
-    communicator->send(m, rank);
-    free(m);
+    mb.withOpcode(MessageOpcode::END_SEARCH);
+    post(mb.withTag(PANO_TAG_SOLVE).build());
 }
 
 UniverseSolverResult RemoteSolver::getResult() {
@@ -247,14 +475,115 @@ UniverseSolverResult RemoteSolver::getResult() {
     return UniverseSolverResult::UNKNOWN;
 }
 
+void RemoteSolver::setIgnoredConstraints(const std::vector<bool> &ignored) {
+    // The runs alternate between ignored and kept constraints, starting with the status of the first one.
+    std::vector<unsigned long> runs;
+    for (unsigned long start = 0, i = 1; i <= ignored.size(); i++) {
+        if ((i == ignored.size()) || (ignored[i] != ignored[start])) {
+            runs.push_back(i - start);
+            start = i;
+        }
+    }
+
+    MessageBuilder mb;
+    mb.withOpcode(MessageOpcode::CONSTRAINTS_SET_IGNORED)
+            .withParameter((!ignored.empty()) && ignored[0])
+            .withUnsigned(runs.size());
+    for (auto length : runs) {
+        mb.withUnsigned(length);
+    }
+    configure(mb.withTag(PANO_TAG_SOLVE).build());
+}
+
+std::future<std::vector<bool>> RemoteSolver::getIgnoredConstraintsAsync(const std::vector<int> &constraints) {
+    MessageBuilder mb;
+    mb.withOpcode(MessageOpcode::CONSTRAINTS_IS_IGNORED).withIndices(constraints);
+    return query<std::vector<bool>>(mb, [](const Message *response) {
+        // The flags are packed, eight constraints per byte.
+        MessageReader reader(response);
+        auto n = reader.readUnsigned();
+        std::vector<bool> ignored(n);
+        unsigned char bits = 0;
+        for (unsigned long long i = 0; i < n; i++) {
+            if ((i % 8) == 0) {
+                bits = reader.read<unsigned char>();
+            }
+            ignored[i] = ((bits >> (i % 8)) & 1) != 0;
+        }
+        return ignored;
+    });
+}
+
+std::future<std::vector<double>> RemoteSolver::getConstraintScoresAsync(const std::vector<int> &constraints) {
+    MessageBuilder mb;
+    mb.withOpcode(MessageOpcode::CONSTRAINTS_SCORE).withIndices(constraints);
+    return query<std::vector<double>>(mb, [](const Message *response) {
+        MessageReader reader(response);
+        return readScores(reader);
+    });
+}
+
+std::vector<double> RemoteSolver::readScores(MessageReader &reader) {
+    std::vector<double> scores;
+    auto n = reader.readUnsigned();
+    scores.reserve(n);
+    for (unsigned long long i = 0; i < n; i++) {
+        scores.push_back(reader.read<double>());
+    }
+    return scores;
+}
+
+void RemoteSolver::subscribeConstraintScores(const std::vector<int> &constraints, long periodMs) {
+    MessageBuilder mb;
+    mb.withOpcode(MessageOpcode::SUBSCRIBE_CONSTRAINTS_SCORE).withInteger(periodMs).withIndices(constraints);
+    send(mb.withTag(PANO_TAG_SOLVE).build());
+}
+
+void RemoteSolver::readConstraintScores(MessageReader &reader) {
+    auto scores = readScores(reader);
+    std::scoped_lock lock(scoresMutex);
+    scoresSnapshot = std::move(scores);
+}
+
+std::vector<double> RemoteSolver::getConstraintScoresSnapshot() {
+    std::scoped_lock lock(scoresMutex);
+    return scoresSnapshot;
+}
+
+void RemoteSolver::setConstraintIgnored(int constraint, bool ignored) {
+    MessageBuilder mb;
+    mb.withOpcode(MessageOpcode::CONSTRAINT_SET_IGNORED);
+    send(mb.withTag(PANO_TAG_SOLVE).withParameter(constraint).withParameter(ignored).build());
+}
+
 void RemoteSolver::loadInstance(const std::string &filename) {
+    invalidateMetadata();
+    forgetAttachedSolution();
     MessageBuilder mb;
-    Message *m = mb.named(PANO_MESSAGE_LOAD_INSTANCE)
-            .withParameter(filename)
+    Message *m = mb.withOpcode(MessageOpcode::LOAD_INSTANCE)
+            .withString(filename)
             .withTag(PANO_TAG_SOLVE)
             .build();
-    communicator->send(m, rank);
-    free(m);
+    configure(m);
+    forgetCapabilities();
+    requestVariableDictionary();
+}
+
+void RemoteSolver::loadReceivedInstance() {
+    invalidateMetadata();
+    forgetAttachedSolution();
+    MessageBuilder mb;
+    configure(mb.withOpcode(MessageOpcode::LOAD_RECEIVED_INSTANCE).withTag(PANO_TAG_SOLVE).build());
+    forgetCapabilities();
+    requestVariableDictionary();
+}
+
+unsigned int RemoteSolver::expectInstance() {
+    return responses.newRequestId();
+}
+
+void RemoteSolver::awaitInstance(unsigned int requestId) {
+    MessageHandle ack(responses.await(requestId));
 }
 
 [[nodiscard]] const std::map<std::string, IUniverseVariable *>
@@ -267,115 +596,96 @@ std::map<std::string, BigInteger> RemoteSolver::mapSolution() {
 }
 
 void RemoteSolver::setLowerBound(const BigInteger &lb) {
+    invalidateMetadata();
     MessageBuilder mb;
-    Message *m = mb.named(PANO_MESSAGE_LOWER_BOUND)
-            .withParameter(lb)
+    Message *m = mb.withOpcode(MessageOpcode::LOWER_BOUND)
+            .withBigInteger(lb)
             .withTag(PANO_TAG_SOLVE)
             .build();
-    communicator->send(m, rank);
-
-    free(m);
+    post(m);
 }
 
 void RemoteSolver::setUpperBound(const BigInteger &ub) {
+    invalidateMetadata();
     MessageBuilder mb;
-    Message *m = mb.named(PANO_MESSAGE_UPPER_BOUND)
-            .withParameter(ub)
+    Message *m = mb.withOpcode(MessageOpcode::UPPER_BOUND)
+            .withBigInteger(ub)
             .withTag(PANO_TAG_SOLVE)
             .build();
-    communicator->send(m, rank);
-    free(m);
+    post(m);
 }
 
 void RemoteSolver::setBounds(const BigInteger &lb,
                              const BigInteger &ub) {
+    invalidateMetadata();
     MessageBuilder mb;
-    Message *m = mb.named(PANO_MESSAGE_LOWER_UPPER_BOUND)
-            .withParameter(lb)
-            .withParameter(ub)
+    Message *m = mb.withOpcode(MessageOpcode::LOWER_UPPER_BOUND)
+            .withBigInteger(lb)
+            .withBigInteger(ub)
             .withTag(PANO_TAG_SOLVE)
             .build();
-    communicator->send(m, rank);
-    free(m);
+    post(m);
 }
 
 BigInteger RemoteSolver::getCurrentBound() {
-    mutex.lock();
-    MessageBuilder mb;
-    Message *m = mb.named(PANO_MESSAGE_GET_CURRENT_BOUND)
-            .withTag(PANO_TAG_RESPONSE)
-            .build();
-    communicator->send(m, rank);
-    free(m);
+    return getCurrentBoundAsync().get();
+}
 
-    m = communicator->receive(PANO_TAG_RESPONSE, rank);
-    std::string param(m->parameters, strlen(m->parameters) + 1);
-    BigInteger newBound = bigIntegerValueOf(param);
-    mutex.unlock();
-    free(m);
-    return newBound;
+std::future<BigInteger> RemoteSolver::getCurrentBoundAsync() {
+    MessageBuilder mb;
+    mb.withOpcode(MessageOpcode::GET_CURRENT_BOUND);
+    return query<BigInteger>(mb, [](const Message *response) {
+        MessageReader reader(response);
+        return reader.readBigInteger();
+    });
 }
 
 bool RemoteSolver::isMinimization() {
-    mutex.lock();
-    MessageBuilder mb;
-    Message *m =
-            mb.named(PANO_MESSAGE_IS_MINIMIZATION).withTag(PANO_TAG_RESPONSE).build();
-    communicator->send(m, rank);
-    free(m);
+    return metadataAsync().get().minimization;
+}
 
-    m = communicator->receive(PANO_TAG_RESPONSE, rank);
-    bool r = m->read<bool>();
-    mutex.unlock();
-    free(m);
-    return r;
+std::future<bool> RemoteSolver::isMinimizationAsync() {
+    return fromMetadata<bool>([](const Metadata &snapshot) {
+        return snapshot.minimization;
+    });
 }
 
 BigInteger RemoteSolver::getLowerBound() {
-    mutex.lock();
-    MessageBuilder mb;
-    Message *m =
-            mb.named(PANO_MESSAGE_GET_LOWER_BOUND).withTag(PANO_TAG_RESPONSE).build();
-    communicator->send(m, rank);
-    free(m);
+    return metadataAsync().get().lowerBound;
+}
 
-    m = communicator->receive(PANO_TAG_RESPONSE, rank);
-    std::string param(m->parameters, strlen(m->parameters) + 1);
-    BigInteger newBound = bigIntegerValueOf(param);
-    mutex.unlock();
-    free(m);
-    return newBound;
+std::future<BigInteger> RemoteSolver::getLowerBoundAsync() {
+    return fromMetadata<BigInteger>([](const Metadata &snapshot) {
+        return snapshot.lowerBound;
+    });
 }
 
 BigInteger RemoteSolver::getUpperBound() {
-    mutex.lock();
-    MessageBuilder mb;
-    Message *m =
-            mb.named(PANO_MESSAGE_GET_UPPER_BOUND).withTag(PANO_TAG_RESPONSE).build();
-    communicator->send(m, rank);
-    free(m);
+    return metadataAsync().get().upperBound;
+}
 
-    m = communicator->receive(PANO_TAG_RESPONSE, rank);
-    std::string param(m->parameters, strlen(m->parameters) + 1);
-    BigInteger newBound = bigIntegerValueOf(param);
-    mutex.unlock();
-    free(m);
-    return newBound;
+std::future<BigInteger> RemoteSolver::getUpperBoundAsync() {
+    return fromMetadata<BigInteger>([](const Metadata &snapshot) {
+        return snapshot.upperBound;
+    });
 }
 
 unsigned int RemoteSolver::getIndex() const {
     return index;
 }
 
+int RemoteSolver::getRank() const {
+    return rank;
+}
+
 void RemoteSolver::decisionVariables(const std::vector<std::string> &variables) {
     MessageBuilder mb;
-    mb.named(PANO_MESSAGE_DECISION_VARIABLES);
+    mb.withOpcode(MessageOpcode::DECISION_VARIABLES).withUnsigned(variables.size());
     for (auto &v: variables) {
-        mb.withParameter(v);
+        mb.withString(v);
     }
     Message *m = mb.withTag(PANO_TAG_SOLVE).build();
-    communicator->send(m, rank);
-    free(m);
+    configure(m);
 }
 
 void RemoteSolver::addSearchListener(IUniverseSearchListener *listener) {
@@ -387,41 +697,24 @@ void RemoteSolver::setLogStream(std::ostream &stream) {
 }
 
 std::map<std::string, BigInteger> RemoteSolver::mapSolution(bool excludeAux) {
-    mutex.lock();
-    MessageBuilder mb;
-    Message *m = mb.named(PANO_MESSAGE_MAP_SOLUTION)
-            .withTag(PANO_TAG_RESPONSE).withParameter(excludeAux)
-            .build();
-    LOG_F(INFO, "avant send");
-    communicator->send(m, rank);
-    LOG_F(INFO, "après send");
-    free(m);
-    unsigned long size =
-            100 * nVariables() * (PANO_VARIABLE_NAME_MAX_CHAR + PANO_NUMBER_MAX_CHAR + 2) + sizeof(Message);
-    LOG_F(INFO, "avant receive");
-    m = communicator->receive(PANO_TAG_RESPONSE, rank, size);
-    LOG_F(INFO, "après receive", m->src);
-    mutex.unlock();
-    std::map<std::string, BigInteger> bigbig;
-    char *ptrName = m->parameters;
-    char *ptrValue = nullptr;
-    char *ptr = m->parameters;
-    for (int i = 0, n = 0; n < m->nbParameters; i++) {
-        if (ptr[i] == '\0') {
-            if (ptrValue == nullptr) {
-                ptrValue = ptr + i + 1;
-            } else {
-                std::string name(ptrName, ptrValue - ptrName - 1);
-                std::string value(ptrValue, ptr + i - ptrValue);
-                bigbig[name] = bigIntegerValueOf(value);
-                ptrValue = nullptr;
-                ptrName = ptr + i + 1;
-            }
-            n++;
+    return mapSolutionAsync(excludeAux).get();
+}
+
+std::future<std::map<std::string, BigInteger>> RemoteSolver::mapSolutionAsync(bool excludeAux) {
+    {
+        // The remote solver always sends the whole mapping, whatever the value of excludeAux.
+        std::scoped_lock lock(attachedSolutionMutex);
+        if (attachedMapSolution) {
+            return ready(*attachedMapSolution);
         }
     }
-    free(m);
-    return bigbig;
+
+    MessageBuilder mb;
+    mb.withOpcode(MessageOpcode::MAP_SOLUTION).withParameter(excludeAux);
+    return query<std::map<std::string, BigInteger>>(mb, [variables = variableDictionary()](const Message *response) {
+        MessageReader reader(response);
+        return readMapSolution(reader, variables.get());
+    });
 }
 
 IOptimizationSolver *RemoteSolver::toOptimizationSolver() {
@@ -429,81 +722,72 @@ IOptimizationSolver *RemoteSolver::toOptimizationSolver() {
 }
 
 const std::vector<std::string> &RemoteSolver::getAuxiliaryVariables() {
-    if (!auxiliaryVariables.empty()) {
-        return auxiliaryVariables;
+    auto snapshot = metadataAsync();
+    const auto &current = snapshot.get().auxiliaryVariables;
+    std::scoped_lock lock(metadataMutex);
+    if (auxiliaryVariables.empty() || (auxiliaryVariables.back() != current)) {
+        // The vectors already returned may still be in use, so they are kept as is.
+        auxiliaryVariables.push_back(current);
     }
-    mutex.lock();
-    MessageBuilder mb;
-    Message *m = mb.named(PANO_MESSAGE_GET_AUXILIARY_VARIABLES)
-            .withTag(PANO_TAG_RESPONSE)
-            .build();
-    communicator->send(m, rank);
-    free(m);
-    unsigned long size = 100 * nVariables() * (PANO_VARIABLE_NAME_MAX_CHAR + 1) + sizeof(Message);
-
-    m = communicator->receive(PANO_TAG_RESPONSE, rank, size);
-    mutex.unlock();
-
-    int n = m->nbParameters;
-    char *ptrName = m->parameters;
-    for (int i = 0; i < n; i++) {
-        std::string name(ptrName, strlen(ptrName) + 1);
-        auxiliaryVariables.push_back(name);
-        ptrName += name.size() + 1;
-    }
-    return auxiliaryVariables;
+    return auxiliaryVariables.back();
 }
 
 void RemoteSolver::valueHeuristicStatic(const std::vector<std::string> &variables,
                                         const std::vector<BigInteger> &orderedValues) {
     MessageBuilder mb;
-    mb.named(PANO_MESSAGE_VALUE_HEURISTIC_STATIC);
-    mb.withParameter((int) variables.size());
+    mb.withOpcode(MessageOpcode::VALUE_HEURISTIC_STATIC);
+    mb.withUnsigned(variables.size());
     for (auto &v: variables) {
-        mb.withParameter(v);
+        mb.withString(v);
     }
-    mb.withParameter((int) orderedValues.size());
+    mb.withUnsigned(orderedValues.size());
     for (auto &v: orderedValues) {
-        mb.withParameter(toString(v));
+        mb.withBigInteger(v);
     }
     Message *m = mb.withTag(PANO_TAG_SOLVE).build();
-    communicator->send(m, rank);
-    free(m);
+    configure(m);
 }
 
 bool RemoteSolver::checkSolution() {
-    mutex.lock();
-    MessageBuilder mb;
-    mb.named(PANO_MESSAGE_CHECK_SOLUTION);
-    Message *m = mb.withTag(PANO_TAG_RESPONSE).build();
-    communicator->send(m, rank);
-    free(m);
+    return checkSolutionAsync().get();
+}
 
-    m = communicator->receive(PANO_TAG_RESPONSE, rank, PANO_DEFAULT_MESSAGE_SIZE);
-    bool b = m->read<bool>();
-    mutex.unlock();
-    free(m);
-    return b;
+std::future<bool> RemoteSolver::checkSolutionAsync() {
+    MessageBuilder mb;
+    mb.withOpcode(MessageOpcode::CHECK_SOLUTION);
+    return query<bool>(mb, [](const Message *response) {
+        return response->read<bool>();
+    });
 }
 
 bool RemoteSolver::checkSolution(const std::map<std::string, BigInteger> &assignment) {
-    mutex.lock();
+    return checkSolutionAsync(assignment).get();
+}
+
+std::future<bool> RemoteSolver::checkSolutionAsync(const std::map<std::string, BigInteger> &assignment) {
+    auto variables = variableDictionary();
     MessageBuilder mb;
-    mb.named(PANO_MESSAGE_CHECK_SOLUTION_ASSIGNMENT);
+    mb.withOpcode(MessageOpcode::CHECK_SOLUTION_ASSIGNMENT)
+            .reserve(assignment.size() * (sizeof(unsigned long) + PANO_NUMBER_MAX_CHAR))
+            .withUnsigned(assignment.size());
     for (auto &kv: assignment) {
-        mb.withParameter(kv.first);
-        mb.withParameter(kv.second);
+        variables.get().writeVariable(mb, kv.first);
+        mb.withBigInteger(kv.second);
     }
-    Message *r = mb.withTag(PANO_TAG_RESPONSE).build();
-    communicator->send(r, rank);
-    free(r);
-    r = communicator->receive(PANO_TAG_RESPONSE, rank, PANO_DEFAULT_MESSAGE_SIZE);
-    bool b = r->read<bool>();
-    mutex.unlock();
-    free(r);
-    return b;
+    return query<bool>(mb, [](const Message *response) {
+        return response->read<bool>();
+    });
 }
 
 const std::vector<IUniverseConstraint *> &RemoteSolver::getConstraints() {
+    // The views only store their index, so they remain valid if the instance changes.
+    auto nbConstraints = (unsigned long) nConstraints();
+    for (auto i = remoteConstraints.size(); i < nbConstraints; i++) {
+        if (i == constraintViews.size()) {
+            constraintViews.emplace_back(this, (int) i);
+        }
+        remoteConstraints.push_back(&constraintViews[i]);
+    }
+    remoteConstraints.resize(nbConstraints);
     return remoteConstraints;
 }
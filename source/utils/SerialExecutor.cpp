@@ -0,0 +1,109 @@
+/**
+ * PANORAMYX - Programming pArallel coNstraint sOlveRs mAde aMazingly easY.
+ * Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see {@link http://www.gnu.org/licenses}.
+ */
+
+/**
+ * @file SerialExecutor.cpp
+ * @brief Executes tasks one after the other on a single long-lived thread.
+ *
+ * @author Thibault Falque
+ * @author Romain Wallon
+ *
+ * @copyright Copyright (c) 2022-2023 - Univ Artois & CNRS & Exakis Nelite.
+ * @license This project is released under the GNU LGPL3 License.
+ */
+
+#include <loguru.hpp>
+
+#include <crillab-except/except.hpp>
+
+#include <crillab-panoramyx/utils/SerialExecutor.hpp>
+
+using namespace std;
+
+using namespace Except;
+using namespace Panoramyx;
+
+SerialExecutor::SerialExecutor(function<void()> onExit) :
+        stopped(false),
+        onExit(std::move(onExit)),
+        worker(&SerialExecutor::run, this) {
+    // Nothing to do: everything is already initialized.
+}
+
+SerialExecutor::~SerialExecutor() {
+    shutdown();
+}
+
+void SerialExecutor::run() {
+    for (;;) {
+        function<void()> task;
+        {
+            unique_lock lock(mutex);
+            condition.wait(lock, [this]() {
+                return stopped || !tasks.empty();
+            });
+            if (tasks.empty()) {
+                // The executor has been shut down, and all its tasks have been executed.
+                break;
+            }
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+
+        try {
+            task();
+        } catch (exception &e) {
+            LOG_F(ERROR, "task failed: %s", e.what());
+        }
+    }
+
+    if (onExit) {
+        onExit();
+    }
+}
+
+void SerialExecutor::execute(function<void()> task) {
+    {
+        scoped_lock lock(mutex);
+        if (stopped) {
+            throw IllegalStateException("executor has been shut down");
+        }
+        tasks.push_back(std::move(task));
+    }
+    condition.notify_one();
+}
+
+unsigned long SerialExecutor::cancelPending() {
+    scoped_lock lock(mutex);
+    auto cancelled = tasks.size();
+    tasks.clear();
+    return cancelled;
+}
+
+void SerialExecutor::shutdown() {
+    {
+        scoped_lock lock(mutex);
+        stopped = true;
+    }
+    condition.notify_one();
+    if (worker.joinable()) {
+        worker.join();
+    }
+}